@@ -50,7 +50,7 @@ namespace ra
     /// <param name="value">The value of the argument in --name=value</param>
     /// <param name="argc">The number of element in argv</param>
     /// <param name="argv">The array of const char * representing each argument within the command line.</param>
-    /// <returns>True when an argument named [name] is found. False otherwise.</returns>
+    /// <returns>True when an argument named [name] is found and its value is a valid number. False otherwise.</returns>
     bool parseArgument(const std::string & name, int & value, int argc, char **argv);
 
     /// <summary>
@@ -61,7 +61,7 @@ namespace ra
     /// <param name="value">The value of the argument in --name=value</param>
     /// <param name="argc">The number of element in argv</param>
     /// <param name="argv">The array of const char * representing each argument within the command line.</param>
-    /// <returns>True when an argument named [name] is found. False otherwise.</returns>
+    /// <returns>True when an argument named [name] is found and its value is a valid number. False otherwise.</returns>
     bool parseArgument(const std::string & name, size_t & value, int argc, char **argv);
 
   } //namespace environment
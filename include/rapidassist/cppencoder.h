@@ -26,6 +26,8 @@
 #define RA_CPPENCODER_H
 
 #include <string>
+#include <vector>
+#include <stddef.h> //for size_t
 
 namespace ra
 {
@@ -73,7 +75,7 @@ namespace ra
 
     /// <summary>
     /// Returns a string literal that contains an octal escape sequence of the given character.
-    /// The returned buffer is private to the function and must be copied to a local variable before the next call to the function.
+    /// The returned string is constant and can be used from multiple threads.
     /// </summary>
     /// <param name="c">The given character</param>
     /// <returns>Returns a string literal that contains an octal escape sequence of the given character.</returns>
@@ -81,7 +83,7 @@ namespace ra
 
     /// <summary>
     /// Returns a string literal that contains an hexadecimal escape sequence of the given character.
-    /// The returned buffer is private to the function and must be copied to a local variable before the next call to the function.
+    /// The returned string is constant and can be used from multiple threads.
     /// </summary>
     /// <param name="c">The given character</param>
     /// <returns>Returns a string literal that contains an hexadecimal escape sequence of the given character.</returns>
@@ -136,6 +138,195 @@ namespace ra
     /// <returns>Returns a string representating an array of bytes which matches the given buffer</returns>
     std::string toCppCharactersArray(const unsigned char * iBuffer, size_t iSize);
 
+    /// <summary>
+    /// Converts the given buffer to a c++ string literals using multiple threads.
+    /// The buffer is partitioned and each partition is encoded concurrently directly to its position in the output.
+    /// The output is identical to toOctString(). Small buffers are encoded on the calling thread.
+    /// </summary>
+    /// <param name="iBuffer">The input buffer to convert</param>
+    /// <param name="iSize">The size in bytes of the given buffer</param>
+    /// <param name="iDisableWarningC4125">Disable generation of code which could generate compilation warning C4125. See toOctString().</param>
+    /// <param name="iNumThreads">The maximum number of threads. Use 0 for the number of processors.</param>
+    /// <returns>Returns the string literals of the given buffer</returns>
+    std::string toOctStringParallel(const unsigned char * iBuffer, size_t iSize, bool iDisableWarningC4125, size_t iNumThreads);
+
+    /// <summary>
+    /// Converts the given buffer to a c++ string literals using multiple threads.
+    /// The output is identical to toHexString(). See toOctStringParallel() for details.
+    /// </summary>
+    /// <param name="iBuffer">The input buffer to convert</param>
+    /// <param name="iSize">The size in bytes of the given buffer</param>
+    /// <param name="iNumThreads">The maximum number of threads. Use 0 for the number of processors.</param>
+    /// <returns>Returns the string literals of the given buffer</returns>
+    std::string toHexStringParallel(const unsigned char * iBuffer, size_t iSize, size_t iNumThreads);
+
+    /// <summary>
+    /// Converts the given buffer to an array of characters using multiple threads.
+    /// The output is identical to toCppCharactersArray(). See toOctStringParallel() for details.
+    /// </summary>
+    /// <param name="iBuffer">The input buffer to convert</param>
+    /// <param name="iSize">The size in bytes of the given buffer</param>
+    /// <param name="iNumThreads">The maximum number of threads. Use 0 for the number of processors.</param>
+    /// <returns>Returns a string representating an array of bytes which matches the given buffer</returns>
+    std::string toCppCharactersArrayParallel(const unsigned char * iBuffer, size_t iSize, size_t iNumThreads);
+
+    /// <summary>
+    /// Defines the representations of a buffer in c++ source code.
+    /// </summary>
+    enum CPP_ENCODING
+    {
+      ENCODING_OCT_STRING,        //string literal with octal escape sequences. See toOctString().
+      ENCODING_HEX_STRING,        //string literal with hexadecimal escape sequences. See toHexString().
+      ENCODING_CHARACTERS_ARRAY,  //array of characters. See toCppCharactersArray().
+    };
+
+    /// <summary>
+    /// Converts the given file to a c++ source file.
+    /// The source file defines a variable named iVariableName with the content of the file
+    /// and a variable named iVariableName_size with the size in bytes of the file.
+    /// Both variables have external linkage: compile the generated file as its own source file
+    /// and access the variables with 'extern const char iVariableName[];' (or 'extern const unsigned char') and 'extern const size_t iVariableName_size;'.
+    /// The file is read and encoded in chunks with a constant amount of memory.
+    /// With ENCODING_OCT_STRING and ENCODING_HEX_STRING, the content is a single string literal and compilers limit its size
+    /// (about 64 KB with Visual Studio, see error C2026). Large files must be encoded with ENCODING_CHARACTERS_ARRAY.
+    /// </summary>
+    /// <param name="iInputFilePath">The path of the file to encode.</param>
+    /// <param name="iOutputFilePath">The path of the c++ source file to generate.</param>
+    /// <param name="iVariableName">The name of the generated variable.</param>
+    /// <param name="iEncoding">The representation of the file content.</param>
+    /// <param name="iLineLength">The maximum number of encoded characters per line. Escape sequences and values are never split. Set to 0 to disable line wrapping.</param>
+    /// <returns>Returns true if the source file was generated. Returns false otherwise.</returns>
+    bool encodeFile(const char * iInputFilePath, const char * iOutputFilePath, const char * iVariableName, CPP_ENCODING iEncoding, size_t iLineLength);
+
+    /// <summary>
+    /// Defines the representations of a block of data selected by toCppSource().
+    /// </summary>
+    enum BLOCK_STRATEGY
+    {
+      STRATEGY_STRING_LITERAL,  //string literal with octal escape sequences. Best for text.
+      STRATEGY_UINT32_ARRAY,    //array of 32 bits words. Best for binary data.
+      STRATEGY_RUN_LENGTH,      //a single value repeated. Best for padding.
+    };
+
+    /// <summary>
+    /// Describes the encoding of a block of data selected by toCppSource().
+    /// </summary>
+    struct BLOCK_ENCODING
+    {
+      size_t offset;            //offset in bytes of the block in the input buffer
+      size_t size;              //size in bytes of the block
+      BLOCK_STRATEGY strategy;  //representation of the block
+      size_t encodedSize;       //size in bytes of the generated code for the block
+    };
+    typedef std::vector<BLOCK_ENCODING> BlockEncodingList;
+
+    /// <summary>
+    /// Converts the given buffer to a c++ source code using the most compact representation for each block of the buffer.
+    /// Long runs of a single value are encoded as run-length blocks. Other blocks are encoded as a string literal or as
+    /// an array of 32 bits words, whichever generates less code. Integer arrays have 4 times less tokens than toCppCharactersArray()
+    /// and string literals are parsed the fastest, so smaller code also compiles faster. The generated code is valid c++98.
+    /// The generated code defines iVariableName_size, the size in bytes of the buffer, and a function
+    /// void iVariableName_decode(unsigned char * oBuffer) which copies the buffer to oBuffer.
+    /// Both have external linkage: compile the generated code as its own source file and access them with
+    /// 'extern const size_t iVariableName_size;' and 'void iVariableName_decode(unsigned char * oBuffer);'.
+    /// </summary>
+    /// <param name="iBuffer">The input buffer to convert</param>
+    /// <param name="iSize">The size in bytes of the given buffer</param>
+    /// <param name="iVariableName">The name of the generated variables and function.</param>
+    /// <param name="oBlocks">The encoding selected for each block of the buffer.</param>
+    /// <returns>Returns the generated c++ source code.</returns>
+    std::string toCppSource(const unsigned char * iBuffer, size_t iSize, const char * iVariableName, BlockEncodingList & oBlocks);
+
+    /// <summary>
+    /// Decodes the content of a c++ string literal generated by toOctString() or toHexString() back into bytes.
+    /// Octal, hexadecimal and simple escape sequences are supported. The surrounding quotes must not be included.
+    /// </summary>
+    /// <param name="iText">The content of the string literal.</param>
+    /// <param name="iLength">The number of characters of the string literal.</param>
+    /// <param name="oBuffer">The output buffer. Must be at least iLength bytes.</param>
+    /// <param name="oSize">The number of bytes written to oBuffer.</param>
+    /// <returns>Returns true if the string literal was decoded. Returns false if the string literal contains an invalid escape sequence or an unescaped quote.</returns>
+    bool decodeStringLiteral(const char * iText, size_t iLength, unsigned char * oBuffer, size_t & oSize);
+
+    /// <summary>
+    /// Decodes an array of characters generated by toCppCharactersArray() back into bytes.
+    /// Values are printable characters (ie 'a') or decimal values separated by commas. White spaces and a trailing comma are allowed.
+    /// </summary>
+    /// <param name="iText">The array of characters, without the surrounding braces.</param>
+    /// <param name="iLength">The number of characters of the array.</param>
+    /// <param name="oBuffer">The output buffer. Must be at least iLength bytes.</param>
+    /// <param name="oSize">The number of bytes written to oBuffer.</param>
+    /// <returns>Returns true if the array was decoded. Returns false if the array contains an invalid value.</returns>
+    bool decodeCharactersArray(const char * iText, size_t iLength, unsigned char * oBuffer, size_t & oSize);
+
+    /// <summary>
+    /// Returns the size in bytes of the hexadecimal representation of a buffer. See encodeHex().
+    /// </summary>
+    /// <param name="iSize">The size in bytes of the buffer to encode.</param>
+    /// <returns>Returns the number of characters written by encodeHex().</returns>
+    size_t getHexEncodedSize(size_t iSize);
+
+    /// <summary>
+    /// Encodes the given buffer as lowercase hexadecimal characters (ie "0aff").
+    /// The output is not NULL terminated.
+    /// </summary>
+    /// <param name="iBuffer">The input buffer to encode.</param>
+    /// <param name="iSize">The size in bytes of the given buffer.</param>
+    /// <param name="oText">The output buffer. Must be at least getHexEncodedSize(iSize) bytes.</param>
+    /// <returns>Returns the number of characters written to the output buffer.</returns>
+    size_t encodeHex(const unsigned char * iBuffer, size_t iSize, char * oText);
+
+    /// <summary>
+    /// Returns the size in bytes of the decoded value of an hexadecimal string. See decodeHex().
+    /// </summary>
+    /// <param name="iLength">The number of hexadecimal characters to decode.</param>
+    /// <returns>Returns the number of bytes written by decodeHex().</returns>
+    size_t getHexDecodedSize(size_t iLength);
+
+    /// <summary>
+    /// Decodes the given hexadecimal characters to binary. Uppercase and lowercase letters are supported.
+    /// </summary>
+    /// <param name="iText">The hexadecimal characters to decode.</param>
+    /// <param name="iLength">The number of characters to decode.</param>
+    /// <param name="oBuffer">The output buffer. Must be at least getHexDecodedSize(iLength) bytes.</param>
+    /// <returns>Returns true if the characters were decoded. Returns false if the length is odd or if a character is not an hexadecimal character.</returns>
+    bool decodeHex(const char * iText, size_t iLength, unsigned char * oBuffer);
+
+    /// <summary>
+    /// Returns the size in bytes of the base64 representation of a buffer, including padding. See encodeBase64().
+    /// </summary>
+    /// <param name="iSize">The size in bytes of the buffer to encode.</param>
+    /// <returns>Returns the number of characters written by encodeBase64().</returns>
+    size_t getBase64EncodedSize(size_t iSize);
+
+    /// <summary>
+    /// Encodes the given buffer to base64 (RFC 4648) using the '+' and '/' alphabet and '=' padding.
+    /// The output is not NULL terminated.
+    /// </summary>
+    /// <param name="iBuffer">The input buffer to encode.</param>
+    /// <param name="iSize">The size in bytes of the given buffer.</param>
+    /// <param name="oText">The output buffer. Must be at least getBase64EncodedSize(iSize) bytes.</param>
+    /// <returns>Returns the number of characters written to the output buffer.</returns>
+    size_t encodeBase64(const unsigned char * iBuffer, size_t iSize, char * oText);
+
+    /// <summary>
+    /// Returns the size in bytes of the decoded value of a base64 string. See decodeBase64().
+    /// Padding characters at the end of the string are taken into account.
+    /// </summary>
+    /// <param name="iText">The base64 characters to decode.</param>
+    /// <param name="iLength">The number of characters to decode.</param>
+    /// <returns>Returns the number of bytes written by decodeBase64().</returns>
+    size_t getBase64DecodedSize(const char * iText, size_t iLength);
+
+    /// <summary>
+    /// Decodes the given base64 (RFC 4648) characters to binary. Padding is optional. White spaces are not allowed.
+    /// </summary>
+    /// <param name="iText">The base64 characters to decode.</param>
+    /// <param name="iLength">The number of characters to decode.</param>
+    /// <param name="oBuffer">The output buffer. Must be at least getBase64DecodedSize(iText, iLength) bytes.</param>
+    /// <returns>Returns true if the characters were decoded. Returns false if the string is not valid base64.</returns>
+    bool decodeBase64(const char * iText, size_t iLength, unsigned char * oBuffer);
+
   } //namespace cppencoder
 } //namespace ra
 
@@ -36,6 +36,47 @@ namespace ra
   namespace filesystem
   {
 
+    /// <summary>
+    /// Type of a file system entry.
+    /// </summary>
+    enum ENTRY_TYPE
+    {
+      ENTRY_NOT_FOUND,  //the entry does not exist or cannot be queried
+      ENTRY_FILE,       //regular file
+      ENTRY_FOLDER,     //directory
+      ENTRY_OTHER,      //device, pipe, socket, etc.
+    };
+
+    /// <summary>
+    /// Metadata of a file system entry. See getFileInfo().
+    /// </summary>
+    struct FILE_INFO
+    {
+      ENTRY_TYPE type;
+      uint64_t size;                      //size in bytes
+      uint64_t modifiedTime;              //number of seconds elapsed since epoch since Jan 1st 1970
+      uint32_t modifiedTimeNanoseconds;   //nanoseconds part of the modified time. Always 0 on Windows.
+      uint32_t mode;                      //permissions and type bits (st_mode)
+      uint64_t inode;                     //inode number. Always 0 on Windows.
+    };
+    typedef std::vector<FILE_INFO> FileInfoList;
+
+    /// <summary>
+    /// Returns the metadata of the given file or folder with a single stat() call.
+    /// </summary>
+    /// <param name="iPath">An valid file or folder path.</param>
+    /// <param name="oInfo">The metadata of the given path. The type is ENTRY_NOT_FOUND and all other fields are 0 if the path cannot be queried.</param>
+    /// <returns>Returns true when the metadata of the given path is found. Returns false otherwise.</returns>
+    bool getFileInfo(const char * iPath, FILE_INFO & oInfo);
+
+    /// <summary>
+    /// Returns the metadata of multiple files or folders. Each path is queried individually. See getFileInfo().
+    /// </summary>
+    /// <param name="iPaths">A list of file or folder paths.</param>
+    /// <param name="oInfos">The metadata of each path, in the same order as iPaths.</param>
+    /// <returns>Returns the number of paths which metadata was found.</returns>
+    size_t getFileInfo(const ra::strings::StringVector & iPaths, FileInfoList & oInfos);
+
     /// <summary>
     /// Normalizes a path.
     /// </summary>
@@ -44,18 +85,42 @@ namespace ra
 
     /// <summary>
     /// Returns the size of the given file path in bytes.
+    /// Files of 4 GB and more are truncated. See getFileSize64().
     /// </summary>
     /// <param name="iPath">An valid file path.</param>
     /// <returns>Returns the size of the given file path in bytes.</returns>
     uint32_t getFileSize(const char * iPath);
 
     /// <summary>
-    /// Returns the size of the given FILE* in bytes.
+    /// Returns the size of the given FILE* in bytes, including data written to the stream but not flushed yet.
+    /// Files larger than what ftell() or uint32_t can represent are not supported. See getFileSize64().
     /// </summary>
     /// <param name="f">An valid FILE pointer.</param>
     /// <returns>Returns the size of the given FILE* in bytes.</returns>
     uint32_t getFileSize(FILE * f);
 
+    /// <summary>
+    /// Returns the size of the given file path in bytes. Supports files of 4 GB and more.
+    /// </summary>
+    /// <param name="iPath">An valid file path.</param>
+    /// <returns>Returns the size of the given file path in bytes. Returns 0 if the file is not found.</returns>
+    uint64_t getFileSize64(const char * iPath);
+
+    /// <summary>
+    /// Returns the size of the given FILE* in bytes. Supports files of 4 GB and more.
+    /// The position of the stream is not modified. Data still in the stream's buffer is not included. Call fflush() first if required.
+    /// </summary>
+    /// <param name="f">An valid FILE pointer.</param>
+    /// <returns>Returns the size of the given FILE* in bytes.</returns>
+    uint64_t getFileSize64(FILE * f);
+
+    /// <summary>
+    /// Returns the size of the given file descriptor in bytes. Supports files of 4 GB and more.
+    /// </summary>
+    /// <param name="iFileDescriptor">An valid file descriptor.</param>
+    /// <returns>Returns the size of the given file descriptor in bytes.</returns>
+    uint64_t getFileDescriptorSize64(int iFileDescriptor);
+
     /// <summary>
     /// Returns the filename of the given path.
     /// </summary>
@@ -94,6 +159,16 @@ namespace ra
     bool findFiles(ra::strings::StringVector & oFiles, const char * iPath, int iDepth);
     inline bool findFiles(ra::strings::StringVector & oFiles, const char * iPath) { return findFiles(oFiles, iPath, -1); }
 
+    /// <summary>
+    /// Find files in a directory / subdirectory.
+    /// </summary>
+    /// <param name="oFiles">The list of files found.</param>
+    /// <param name="iPath">An valid folder path.</param>
+    /// <param name="iDepth">The search depth. Use 0 for finding files in folder iPath (without subfolders). Use -1 for find all files in folder iPath (including subfolders). </param>
+    /// <returns>Returns true when oFiles contains the list of files from folder iPath. Returns false otherwise.</returns>
+    bool findFiles(ra::strings::StringList & oFiles, const char * iPath, int iDepth);
+    inline bool findFiles(ra::strings::StringList & oFiles, const char * iPath) { return findFiles(oFiles, iPath, -1); }
+
     /// <summary>
     /// Determine if a folder exists.
     /// </summary>
@@ -31,6 +31,7 @@
 #include "strings.h"
 
 using ra::strings::StringVector;
+using ra::strings::StringList;
 
 namespace ra
 {
@@ -86,6 +87,7 @@ namespace ra
     //   oLines:      The content of the file line by line.
     // 
     bool getTextFileContent(const char* iFilename, StringVector & oLines );
+    bool getTextFileContent(const char* iFilename, StringList & oLines );
 
     //
     // Description:
@@ -157,6 +159,16 @@ namespace ra
     //
     StringVector getTestList(const char * iTestCasePath);
 
+    //
+    // Description
+    //  Same as getTestList() but stores the test cases in oTests.
+    //  Returns true when the test list was successfully retreived.
+    // Arguments:
+    //  iTestCasePath:    Path to the GTest compatible executable file
+    //  oTests:           The list of runnable test cases
+    //
+    bool getTestList(const char * iTestCasePath, StringList & oTests);
+
     //
     // Description
     //  Returns true if the specified processor flag is enabled
@@ -0,0 +1,118 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef RA_HASH_H
+#define RA_HASH_H
+
+#include <stdint.h>
+#include <stddef.h> //for size_t
+#include <string>
+
+namespace ra
+{
+  namespace hash
+  {
+
+    /// <summary>
+    /// Computes a fast non-cryptographic 64 bits hash (XXH64) of a buffer.
+    /// The hash is stable across platforms and versions and can be stored.
+    /// </summary>
+    /// <param name="iBuffer">The buffer to hash.</param>
+    /// <param name="iSize">The size in bytes of the buffer.</param>
+    /// <param name="iSeed">The seed of the hash.</param>
+    /// <returns>Returns the 64 bits hash of the buffer.</returns>
+    uint64_t hash64(const void * iBuffer, size_t iSize, uint64_t iSeed = 0);
+
+    /// <summary>
+    /// Computes a fast non-cryptographic 64 bits hash (XXH64) of a string.
+    /// Use the buffer version for hashing a string with a seed.
+    /// </summary>
+    /// <param name="iValue">The string to hash.</param>
+    /// <returns>Returns the 64 bits hash of the string.</returns>
+    uint64_t hash64(const std::string & iValue);
+
+    /// <summary>
+    /// Computes the 64 bits hash (XXH64) of data that is provided in multiple parts.
+    /// The result is identical to calling hash64() on the concatenation of all parts.
+    /// </summary>
+    class Hasher64
+    {
+    public:
+      explicit Hasher64(uint64_t iSeed = 0);
+
+      /// <summary>
+      /// Restarts the hash computation with the given seed.
+      /// </summary>
+      /// <param name="iSeed">The seed of the hash.</param>
+      void reset(uint64_t iSeed = 0);
+
+      /// <summary>
+      /// Adds the given buffer to the hash computation.
+      /// </summary>
+      /// <param name="iBuffer">The buffer to hash.</param>
+      /// <param name="iSize">The size in bytes of the buffer.</param>
+      void update(const void * iBuffer, size_t iSize);
+      void update(const std::string & iValue);
+
+      /// <summary>
+      /// Returns the hash of all the data added so far. More data can be added after calling digest().
+      /// </summary>
+      /// <returns>Returns the 64 bits hash of all the data added so far.</returns>
+      uint64_t digest() const;
+
+    private:
+      uint64_t mSeed;
+      uint64_t mAccumulators[4];
+      uint64_t mTotalSize;
+      unsigned char mBuffer[32]; //pending data which does not fill a full stripe
+      size_t mBufferSize;
+    };
+
+    /// <summary>
+    /// Computes the CRC-32C (Castagnoli) checksum of a buffer.
+    /// The SSE 4.2 crc32 instruction is used when supported by the processor.
+    /// </summary>
+    /// <param name="iBuffer">The buffer to checksum.</param>
+    /// <param name="iSize">The size in bytes of the buffer.</param>
+    /// <param name="iCrc">The checksum of the previous data for computing the checksum of data provided in multiple parts. Use 0 for the first part.</param>
+    /// <returns>Returns the CRC-32C checksum of the buffer.</returns>
+    uint32_t crc32c(const void * iBuffer, size_t iSize, uint32_t iCrc = 0);
+
+    /// <summary>
+    /// Computes the CRC-32C (Castagnoli) checksum of a string.
+    /// </summary>
+    /// <param name="iValue">The string to checksum.</param>
+    /// <returns>Returns the CRC-32C checksum of the string.</returns>
+    uint32_t crc32c(const std::string & iValue);
+
+    /// <summary>
+    /// Defines if crc32c() uses the processor's crc32 instruction.
+    /// </summary>
+    /// <returns>Returns true if crc32c() is accelerated by hardware. Returns false otherwise.</returns>
+    bool isCrc32cAccelerated();
+
+  } //namespace hash
+} //namespace ra
+
+#endif //RA_HASH_H
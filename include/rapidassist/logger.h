@@ -27,6 +27,8 @@
 
 #include <string>
 
+#include "strings.h" //for RA_PRINTF_FORMAT
+
 namespace ra
 {
   namespace logger
@@ -60,7 +62,7 @@ namespace ra
     /// </summary>
     /// <param name="iLevel">The level of the given arguments</param>
     /// <param name="iFormat">The format of the given argument. Same as printf's format.</param>
-    void log(LOGGER_LEVEL iLevel, const char * iFormat, ...);
+    void log(LOGGER_LEVEL iLevel, const char * iFormat, ...) RA_PRINTF_FORMAT(2, 3);
 
 
   } //namespace environment
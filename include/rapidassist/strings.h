@@ -28,7 +28,21 @@
 #include <stdint.h>
 #include <string>
 #include <vector>
+#include <iterator> //for std::forward_iterator_tag
+#include <stddef.h> //for ptrdiff_t
 #include <stdio.h>
+#include <string.h> //for strlen()
+#include <stdarg.h> //for va_list
+
+/// <summary>
+/// Declares a function with printf-like arguments. This allows compilers that supports it
+/// to validate the format string against the given arguments at compile time.
+/// </summary>
+#if defined(__GNUC__)
+#define RA_PRINTF_FORMAT(formatIndex, firstArgIndex) __attribute__((format(printf, formatIndex, firstArgIndex)))
+#else
+#define RA_PRINTF_FORMAT(formatIndex, firstArgIndex)
+#endif
 
 namespace ra
 {
@@ -36,6 +50,227 @@ namespace ra
   {
     typedef std::vector<std::string> StringVector;
 
+    /// <summary>
+    /// A lightweight read-only reference to a sequence of characters owned by another buffer.
+    /// A StringRef never allocates or copies characters. The referenced buffer must outlive the StringRef.
+    /// Note that the referenced characters are not necessarily NULL terminated.
+    /// </summary>
+    class StringRef
+    {
+    public:
+      StringRef() : mData(NULL), mSize(0) {}
+      StringRef(const char * iData, size_t iSize) : mData(iData), mSize(iSize) {}
+      StringRef(const char * iValue) : mData(iValue), mSize(iValue == NULL ? 0 : strlen(iValue)) {}
+      StringRef(const std::string & iValue) : mData(iValue.data()), mSize(iValue.size()) {}
+
+      inline const char * data() const { return mData; }
+      inline size_t size() const { return mSize; }
+      inline bool empty() const { return mSize == 0; }
+      inline const char * begin() const { return mData; }
+      inline const char * end() const { return mData + mSize; }
+      inline const char & operator[](size_t i) const { return mData[i]; }
+
+      /// <summary>
+      /// Returns a copy of the referenced characters.
+      /// </summary>
+      /// <returns>Returns a copy of the referenced characters.</returns>
+      inline std::string toString() const { return std::string(mData, mSize); }
+
+    private:
+      const char * mData;
+      size_t mSize;
+    };
+    typedef std::vector<StringRef> StringRefVector;
+
+    inline bool operator==(const StringRef & a, const StringRef & b) { return a.size() == b.size() && (a.size() == 0 || memcmp(a.data(), b.data(), a.size()) == 0); }
+    inline bool operator!=(const StringRef & a, const StringRef & b) { return !(a == b); }
+
+    /// <summary>
+    /// Lazily splits a text into tokens based on the given splitting pattern.
+    /// Each token is returned as a StringRef within the given text: no token is ever copied or allocated.
+    /// The returned tokens are identical to the ones returned by splitString().
+    /// </summary>
+    class StringTokenizer
+    {
+    public:
+      /// <summary>
+      /// Creates a tokenizer over the given text. Both iText and iSplitPattern must outlive the tokenizer.
+      /// </summary>
+      /// <param name="iText">The input text to split.</param>
+      /// <param name="iSplitPattern">The splitting pattern. An empty pattern returns the whole text as a single token.</param>
+      StringTokenizer(const StringRef & iText, const StringRef & iSplitPattern);
+
+      /// <summary>
+      /// Reads the next token of the text.
+      /// </summary>
+      /// <param name="oToken">The output token.</param>
+      /// <returns>Returns true when a token was found. Returns false when all tokens were read.</returns>
+      bool next(StringRef & oToken);
+
+      /// <summary>
+      /// Restarts tokenization from the beginning of the text.
+      /// </summary>
+      void reset();
+
+    private:
+      StringRef mText;
+      StringRef mPattern;
+      size_t mPosition;
+      bool mFoundSeparator;
+      bool mFinished;
+    };
+
+    /// <summary>
+    /// Lazily splits a text into lines. Lines can be terminated by LF, CRLF or CR characters.
+    /// Each line is returned as a StringRef within the given text, without its terminating characters.
+    /// A terminator at the very end of the text does not start an additional empty line.
+    /// </summary>
+    class LineTokenizer
+    {
+    public:
+      /// <summary>
+      /// Creates a tokenizer over the given text. The text must outlive the tokenizer.
+      /// </summary>
+      /// <param name="iText">The input text to split. For instance, the content of a file.</param>
+      LineTokenizer(const StringRef & iText);
+
+      /// <summary>
+      /// Reads the next line of the text.
+      /// </summary>
+      /// <param name="oLine">The output line without its terminating characters.</param>
+      /// <returns>Returns true when a line was found. Returns false when all lines were read.</returns>
+      bool next(StringRef & oLine);
+
+      /// <summary>
+      /// Restarts tokenization from the beginning of the text.
+      /// </summary>
+      void reset();
+
+      /// <summary>
+      /// Returns the number of lines read so far. After a successful call to next(), this is the line number of the returned line.
+      /// </summary>
+      inline size_t getLineNumber() const { return mLineNumber; }
+
+    private:
+      StringRef mText;
+      size_t mPosition;
+      size_t mLineNumber;
+    };
+
+    /// <summary>
+    /// A list of strings which stores all characters in a single contiguous buffer.
+    /// Each string is NULL terminated within the buffer and is referenced by an (offset, length) entry.
+    /// Adding a string never allocates a new heap block per element which makes large lists
+    /// faster to build, iterate and destroy than a StringVector.
+    /// </summary>
+    class StringList
+    {
+    public:
+      /// <summary>
+      /// Iterates over the elements of a StringList. Each element is returned as a StringRef.
+      /// </summary>
+      class const_iterator
+      {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef StringRef value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const StringRef * pointer;
+        typedef StringRef reference;
+
+        const_iterator() : mList(NULL), mIndex(0) {}
+        const_iterator(const StringList * iList, size_t iIndex) : mList(iList), mIndex(iIndex) {}
+
+        inline StringRef operator*() const { return (*mList)[mIndex]; }
+        inline const_iterator & operator++() { mIndex++; return *this; }
+        inline const_iterator operator++(int) { const_iterator tmp = *this; mIndex++; return tmp; }
+        inline bool operator==(const const_iterator & iOther) const { return mIndex == iOther.mIndex && mList == iOther.mList; }
+        inline bool operator!=(const const_iterator & iOther) const { return !(*this == iOther); }
+        inline size_t index() const { return mIndex; }
+
+      private:
+        const StringList * mList;
+        size_t mIndex;
+      };
+
+      StringList();
+      explicit StringList(const StringVector & iValues);
+
+      /// <summary>
+      /// Removes all elements from the list. The allocated memory is kept for reuse.
+      /// </summary>
+      void clear();
+
+      /// <summary>
+      /// Preallocates memory for the given number of elements and characters.
+      /// </summary>
+      /// <param name="iCount">The expected number of elements.</param>
+      /// <param name="iCharacters">The expected total number of characters of all elements.</param>
+      void reserve(size_t iCount, size_t iCharacters);
+
+      inline size_t size() const { return mEntries.size(); }
+      inline bool empty() const { return mEntries.empty(); }
+
+      /// <summary>
+      /// Appends a copy of the given string at the end of the list.
+      /// </summary>
+      /// <param name="iValue">The string to add.</param>
+      void push_back(const StringRef & iValue);
+
+      /// <summary>
+      /// Removes the last element of the list.
+      /// </summary>
+      void pop_back();
+
+      /// <summary>
+      /// Returns the element at the given index. The reference is valid until the list is modified.
+      /// </summary>
+      inline StringRef operator[](size_t i) const { return StringRef(&mBuffer[mEntries[i].offset], mEntries[i].length); }
+      inline StringRef front() const { return (*this)[0]; }
+      inline StringRef back() const { return (*this)[mEntries.size() - 1]; }
+
+      /// <summary>
+      /// Returns the element at the given index as a NULL terminated string. The pointer is valid until the list is modified.
+      /// </summary>
+      inline const char * c_str(size_t i) const { return &mBuffer[mEntries[i].offset]; }
+
+      inline const_iterator begin() const { return const_iterator(this, 0); }
+      inline const_iterator end() const { return const_iterator(this, mEntries.size()); }
+
+      /// <summary>
+      /// Sorts the elements of the list in ascending order.
+      /// Only the (offset, length) entries are moved. The characters stay in place.
+      /// </summary>
+      void sort();
+
+      /// <summary>
+      /// Replaces the content of the list by a copy of the given values.
+      /// </summary>
+      /// <param name="iValues">The values to copy.</param>
+      void assign(const StringVector & iValues);
+
+      /// <summary>
+      /// Copies all elements of the list into oValues.
+      /// </summary>
+      /// <param name="oValues">The output list of string.</param>
+      void toStringVector(StringVector & oValues) const;
+
+      /// <summary>
+      /// Exchanges the content of the list with another list.
+      /// </summary>
+      void swap(StringList & ioOther);
+
+      struct ENTRY
+      {
+        size_t offset;
+        size_t length;
+      };
+
+    private:
+      std::vector<char> mBuffer;
+      std::vector<ENTRY> mEntries;
+    };
+
     /// <summary>
     /// Defines if a string value is a numeric value.
     /// A numeric value can be positive or negative.
@@ -44,6 +279,28 @@ namespace ra
     /// <returns>True when iValue is numeric. False otherwise.</returns>
     bool isNumeric(const char * iValue);
 
+    /// <summary>
+    /// Defines if a string value is a numeric value.
+    /// A numeric value can be positive or negative.
+    /// A numeric value can be an integer or a floating point value.
+    /// A numeric value must contain at least one digit.
+    /// </summary>
+    /// <param name="iValue">The value to validate. The value does not need to be NULL terminated.</param>
+    /// <param name="iAllowExponent">Allows scientific notation. For instance "1.5e-3".</param>
+    /// <returns>True when iValue is numeric. False otherwise.</returns>
+    bool isNumeric(const StringRef & iValue, bool iAllowExponent);
+
+    /// <summary>
+    /// Validates an array of string values with isNumeric().
+    /// The result of value i is stored in bit (i % 8) of oBitmap[i / 8].
+    /// </summary>
+    /// <param name="iValues">The values to validate.</param>
+    /// <param name="iCount">The number of values in iValues.</param>
+    /// <param name="oBitmap">The output bitmap. Must be at least (iCount + 7) / 8 bytes long.</param>
+    /// <param name="iAllowExponent">Allows scientific notation. For instance "1.5e-3".</param>
+    /// <returns>Returns the number of numeric values.</returns>
+    size_t isNumericBatch(const StringRef * iValues, size_t iCount, uint8_t * oBitmap, bool iAllowExponent);
+
     /// <summary>
     /// Replace an occurance of a string by another.
     /// </summary>
@@ -53,6 +310,73 @@ namespace ra
     /// <returns>Returns the number of token that was replaced.</returns>
     int strReplace(std::string & iString, const char * iOldValue, const char * iNewValue);
 
+    /// <summary>
+    /// Replace all occurances of a string by another and store the result in oOutput.
+    /// The output is built in a single pass with a single allocation of the exact output size.
+    /// </summary>
+    /// <param name="oOutput">The output string.</param>
+    /// <param name="iString">The given string that need to be searched.</param>
+    /// <param name="iOldValue">The old value to replace.</param>
+    /// <param name="iNewValue">The new value to replace.</param>
+    /// <returns>Returns the number of token that was replaced.</returns>
+    int strReplace(std::string & oOutput, const std::string & iString, const char * iOldValue, const char * iNewValue);
+
+    /// <summary>
+    /// Replace multiple strings by other strings in a single scan of the given string.
+    /// When multiple old values match at the same position, the longest one is replaced.
+    /// </summary>
+    /// <param name="iString">The given string that need to be searched.</param>
+    /// <param name="iOldValues">The list of old values to replace.</param>
+    /// <param name="iNewValues">The list of new values matching each old value.</param>
+    /// <returns>Returns the number of token that was replaced.</returns>
+    int strReplace(std::string & iString, const StringVector & iOldValues, const StringVector & iNewValues);
+
+    /// <summary>
+    /// Replaces multiple strings by other strings in a single scan.
+    /// The old values are compiled once in a trie which allows reusing the same replacer on many strings.
+    /// When multiple old values match at the same position, the longest one is replaced.
+    /// </summary>
+    class StringReplacer
+    {
+    public:
+      StringReplacer();
+
+      /// <summary>
+      /// Removes all registered replacements.
+      /// </summary>
+      void clear();
+
+      /// <summary>
+      /// Registers a new replacement. Empty old values are ignored.
+      /// </summary>
+      /// <param name="iOldValue">The old value to replace.</param>
+      /// <param name="iNewValue">The new value to replace.</param>
+      void add(const StringRef & iOldValue, const StringRef & iNewValue);
+
+      /// <summary>
+      /// Replace all registered values in the given text and store the result in oOutput.
+      /// </summary>
+      /// <param name="oOutput">The output string.</param>
+      /// <param name="iText">The given text that need to be searched.</param>
+      /// <returns>Returns the number of token that was replaced.</returns>
+      int replace(std::string & oOutput, const StringRef & iText) const;
+
+      /// <summary>
+      /// Replace all registered values in the given string.
+      /// </summary>
+      /// <param name="ioString">The given string that need to be searched.</param>
+      /// <returns>Returns the number of token that was replaced.</returns>
+      int replace(std::string & ioString) const;
+
+    private:
+      StringVector mOldValues;
+      StringVector mNewValues;
+      std::vector<int> mNodeValues;  //index of the replacement ending at each trie node. -1 if none.
+      std::vector<int> mAlphabet;    //column of each byte value in mTransitions. 0 for bytes not used by any old value.
+      size_t mAlphabetSize;          //number of transitions per trie node (bytes used by old values, plus 1)
+      std::vector<int> mTransitions; //mAlphabetSize transitions per trie node. 0 if none.
+    };
+
     /// <summary>
     /// Converts the given value to string.
     /// </summary>
@@ -60,8 +384,90 @@ namespace ra
     /// <returns>Converts the given value to string.</returns>
     std::string toString(const uint64_t & value);
 
+    /// <summary>
+    /// The minimum size in bytes of the output buffer given to toChars() functions.
+    /// The size includes the NULL terminating character.
+    /// </summary>
+    static const size_t TOCHARS_BUFFER_SIZE = 32;
+
+    /// <summary>
+    /// Converts the given value to a NULL terminated string written in the given buffer.
+    /// The conversion does not allocate memory and does not depend on stream locales. Floating point values always use a '.' decimal point regardless of the LC_NUMERIC locale.
+    /// </summary>
+    /// <param name="oBuffer">The output buffer. Must be at least TOCHARS_BUFFER_SIZE bytes.</param>
+    /// <param name="value">The numeric value.</param>
+    /// <returns>Returns the number of characters written in oBuffer excluding the NULL terminating character.</returns>
+    size_t toChars(char * oBuffer, const int8_t   & value);
+    size_t toChars(char * oBuffer, const uint8_t  & value);
+    size_t toChars(char * oBuffer, const int16_t  & value);
+    size_t toChars(char * oBuffer, const uint16_t & value);
+    size_t toChars(char * oBuffer, const int32_t  & value);
+    size_t toChars(char * oBuffer, const uint32_t & value);
+    size_t toChars(char * oBuffer, const int64_t  & value);
+    size_t toChars(char * oBuffer, const uint64_t & value);
+
+    /// <summary>
+    /// Converts the given floating point value to a NULL terminated string written in the given buffer.
+    /// The function writes the shortest representation that converts back to the exact same value.
+    /// </summary>
+    /// <param name="oBuffer">The output buffer. Must be at least TOCHARS_BUFFER_SIZE bytes.</param>
+    /// <param name="value">The numeric value.</param>
+    /// <returns>Returns the number of characters written in oBuffer excluding the NULL terminating character.</returns>
+    size_t toChars(char * oBuffer, const float  & value);
+    size_t toChars(char * oBuffer, const double & value);
+
+    /// <summary>
+    /// Error codes returned by fromChars() functions.
+    /// </summary>
+    enum FROMCHARS_ERROR
+    {
+      FROMCHARS_SUCCESS,          //the value was parsed successfully
+      FROMCHARS_INVALID_ARGUMENT, //no numeric value found at the beginning of the input
+      FROMCHARS_OUT_OF_RANGE,     //the numeric value does not fit in the output type
+    };
+
+    /// <summary>
+    /// Result of fromChars() functions.
+    /// </summary>
+    struct FROMCHARS_RESULT
+    {
+      const char * ptr;      //pointer to the first character which is not part of the parsed value
+      FROMCHARS_ERROR error; //the parsing error code
+    };
+
+    /// <summary>
+    /// Parse the numeric value at the beginning of the given range of characters.
+    /// The functions do not allocate memory, do not depend on locales and never skip leading whitespace.
+    /// A leading '-' sign is only accepted for signed types. On failure, oValue is left unmodified.
+    /// </summary>
+    /// <param name="iFirst">The first character of the range to parse.</param>
+    /// <param name="iLast">The end of the range (one past the last character) to parse.</param>
+    /// <param name="oValue">The output numeric value.</param>
+    /// <param name="iBase">The numeric base of the value. Must be 10 (default) or 16.</param>
+    /// <returns>Returns a FROMCHARS_RESULT which contains the end of the parsed value and an error code.</returns>
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, int8_t   & oValue, int iBase = 10);
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, uint8_t  & oValue, int iBase = 10);
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, int16_t  & oValue, int iBase = 10);
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, uint16_t & oValue, int iBase = 10);
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, int32_t  & oValue, int iBase = 10);
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, uint32_t & oValue, int iBase = 10);
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, int64_t  & oValue, int iBase = 10);
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, uint64_t & oValue, int iBase = 10);
+
+    /// <summary>
+    /// Parse the floating point value at the beginning of the given range of characters.
+    /// The accepted format is [-]digits[.digits][(e|E)[+|-]digits] or the special values inf, infinity and nan.
+    /// </summary>
+    /// <param name="iFirst">The first character of the range to parse.</param>
+    /// <param name="iLast">The end of the range (one past the last character) to parse.</param>
+    /// <param name="oValue">The output numeric value.</param>
+    /// <returns>Returns a FROMCHARS_RESULT which contains the end of the parsed value and an error code.</returns>
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, float  & oValue);
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, double & oValue);
+
     /// <summary>
     /// Parse the given string into the given numeric variable.
+    /// The whole string must be a valid numeric value. See fromChars() for details.
     /// </summary>
     /// <param name="str">The input string which contains a numeric value.</param>
     /// <param name="oValue">The output numeric value.</param>
@@ -89,6 +495,62 @@ namespace ra
     /// <returns>Returns the given string lowercased.</returns>
     std::string lowercase(const std::string & iValue);
 
+    /// <summary>
+    /// Upper case all ASCII characters of the given buffer. Non ASCII characters are left unmodified.
+    /// The conversion does not depend on locales and is vectorized when the processor supports it.
+    /// </summary>
+    /// <param name="oBuffer">The output buffer. Can be identical to iValue for converting in place.</param>
+    /// <param name="iValue">The input characters.</param>
+    /// <param name="iSize">The number of characters to convert.</param>
+    void uppercase(char * oBuffer, const char * iValue, size_t iSize);
+
+    /// <summary>
+    /// Lower case all ASCII characters of the given buffer. Non ASCII characters are left unmodified.
+    /// The conversion does not depend on locales and is vectorized when the processor supports it.
+    /// </summary>
+    /// <param name="oBuffer">The output buffer. Can be identical to iValue for converting in place.</param>
+    /// <param name="iValue">The input characters.</param>
+    /// <param name="iSize">The number of characters to convert.</param>
+    void lowercase(char * oBuffer, const char * iValue, size_t iSize);
+
+    /// <summary>
+    /// Upper case all ASCII characters of the given string in place.
+    /// </summary>
+    /// <param name="ioValue">The string value to uppercase.</param>
+    void uppercaseInPlace(std::string & ioValue);
+
+    /// <summary>
+    /// Lower case all ASCII characters of the given string in place.
+    /// </summary>
+    /// <param name="ioValue">The string value to lowercase.</param>
+    void lowercaseInPlace(std::string & ioValue);
+
+    /// <summary>
+    /// Returns true if both given strings are identical, ignoring the case of ASCII characters.
+    /// </summary>
+    /// <param name="a">The first string.</param>
+    /// <param name="b">The second string.</param>
+    /// <returns>Returns true if both given strings are identical, ignoring the case of ASCII characters.</returns>
+    bool equalsIgnoreCase(const StringRef & a, const StringRef & b);
+
+    /// <summary>
+    /// Compares two strings lexicographically, ignoring the case of ASCII characters.
+    /// </summary>
+    /// <param name="a">The first string.</param>
+    /// <param name="b">The second string.</param>
+    /// <returns>Returns a negative value if a is lower than b, zero if both strings are identical and a positive value if a is greater than b.</returns>
+    int compareIgnoreCase(const StringRef & a, const StringRef & b);
+
+    /// <summary>
+    /// Search for the first occurrence of a value in a text, ignoring the case of ASCII characters.
+    /// </summary>
+    /// <param name="iText">The text to search into.</param>
+    /// <param name="iValue">The value to search for.</param>
+    /// <param name="iOffset">The offset in iText where the search starts.</param>
+    /// <returns>Returns the offset of the first occurrence of iValue in iText. Returns std::string::npos if not found.</returns>
+    size_t findIgnoreCase(const StringRef & iText, const StringRef & iValue, size_t iOffset);
+    inline size_t findIgnoreCase(const StringRef & iText, const StringRef & iValue) { return findIgnoreCase(iText, iValue, 0); }
+
     /// <summary>
     /// Removes occurance of unix/windows LF, CR or CRLF into the given string.
     /// </summary>
@@ -127,6 +589,45 @@ namespace ra
     /// <param name="iSplitPattern">The splitting pattern.</param>
     void splitString(StringVector & oList, const std::string & iText, const char * iSplitPattern);
 
+    /// <summary>
+    /// Splits an input string into multiple tokens based on the given splitting pattern and store the result in oList.
+    /// Each token references the characters of iText which must outlive the content of oList. No token is copied.
+    /// </summary>
+    /// <param name="oList">The output list of tokens.</param>
+    /// <param name="iText">The input text to split.</param>
+    /// <param name="iSplitPattern">The splitting pattern.</param>
+    void splitString(StringRefVector & oList, const StringRef & iText, const char * iSplitPattern);
+
+    /// <summary>
+    /// Splits an input string into multiple string based on the given splitting pattern and store the result in oList.
+    /// </summary>
+    /// <param name="oList">The output list of string.</param>
+    /// <param name="iText">The input text to split.</param>
+    /// <param name="iSplitPattern">The splitting pattern.</param>
+    void splitString(StringList & oList, const StringRef & iText, const char * iSplitPattern);
+
+    /// <summary>
+    /// Splits an input string into multiple tokens using multiple threads and store the result in oList.
+    /// The text is partitioned at separator boundaries and each partition is split concurrently.
+    /// The output is identical to splitString(). Small texts and patterns which can overlap themselves (for instance "aa") are split on the calling thread.
+    /// Each token references the characters of iText which must outlive the content of oList.
+    /// </summary>
+    /// <param name="oList">The output list of tokens.</param>
+    /// <param name="iText">The input text to split.</param>
+    /// <param name="iSplitPattern">The splitting pattern.</param>
+    /// <param name="iNumThreads">The maximum number of threads. Use 0 for the number of processors.</param>
+    void splitStringParallel(StringRefVector & oList, const StringRef & iText, const char * iSplitPattern, size_t iNumThreads);
+
+    /// <summary>
+    /// Splits an input string into multiple string using multiple threads and store the result in oList.
+    /// The output is identical to splitString(). See the StringRefVector overload for details.
+    /// </summary>
+    /// <param name="oList">The output list of string.</param>
+    /// <param name="iText">The input text to split.</param>
+    /// <param name="iSplitPattern">The splitting pattern.</param>
+    /// <param name="iNumThreads">The maximum number of threads. Use 0 for the number of processors.</param>
+    void splitStringParallel(StringVector & oList, const StringRef & iText, const char * iSplitPattern, size_t iNumThreads);
+
     /// <summary>
     /// Join a list of strings into a single string separating each element by iSeparator.
     /// </summary>
@@ -135,6 +636,68 @@ namespace ra
     /// <returns>Returns a list of strings merged into a single string separating each element by iSeparator.</returns>
     std::string joinString(const StringVector & iList, const char * iSeparator);
 
+    /// <summary>
+    /// Join a list of strings into a single string separating each element by iSeparator.
+    /// </summary>
+    /// <param name="iList">The list of elements to join.</param>
+    /// <param name="iSeparator">The string separator.</param>
+    /// <returns>Returns a list of strings merged into a single string separating each element by iSeparator.</returns>
+    std::string joinString(const StringList & iList, const char * iSeparator);
+
+    /// <summary>
+    /// Join a range of strings at the end of an existing string separating each element by iSeparator.
+    /// The exact length of the output is computed before appending which allows a single allocation.
+    /// Like joinString(), no separator is inserted before the first non-empty element of the range.
+    /// </summary>
+    /// <param name="ioOutput">The string to append to.</param>
+    /// <param name="iFirst">An iterator to the first element to join. Elements must be convertible to StringRef.</param>
+    /// <param name="iLast">An iterator past the last element to join. The range is read twice.</param>
+    /// <param name="iSeparator">The string separator.</param>
+    template <class ITERATOR>
+    inline void appendJoinString(std::string & ioOutput, ITERATOR iFirst, ITERATOR iLast, const char * iSeparator)
+    {
+      const StringRef separator(iSeparator);
+
+      //first pass: compute the exact output size
+      size_t size = 0;
+      bool foundValue = false;
+      for(ITERATOR it = iFirst; it != iLast; ++it)
+      {
+        const StringRef value(*it);
+        if (foundValue)
+          size += separator.size();
+        size += value.size();
+        foundValue = foundValue || !value.empty();
+      }
+      ioOutput.reserve(ioOutput.size() + size);
+
+      //second pass: append the elements
+      foundValue = false;
+      for(ITERATOR it = iFirst; it != iLast; ++it)
+      {
+        const StringRef value(*it);
+        if (foundValue)
+          ioOutput.append(separator.data(), separator.size());
+        ioOutput.append(value.data(), value.size());
+        foundValue = foundValue || !value.empty();
+      }
+    }
+
+    /// <summary>
+    /// Join a range of strings into a single string separating each element by iSeparator.
+    /// </summary>
+    /// <param name="iFirst">An iterator to the first element to join. Elements must be convertible to StringRef.</param>
+    /// <param name="iLast">An iterator past the last element to join. The range is read twice.</param>
+    /// <param name="iSeparator">The string separator.</param>
+    /// <returns>Returns the range of strings merged into a single string separating each element by iSeparator.</returns>
+    template <class ITERATOR>
+    inline std::string joinString(ITERATOR iFirst, ITERATOR iLast, const char * iSeparator)
+    {
+      std::string output;
+      appendJoinString(output, iFirst, iLast, iSeparator);
+      return output;
+    }
+
     /// <summary>
     /// Removes left and right space characters of the given string.
     /// </summary>
@@ -146,7 +709,7 @@ namespace ra
     /// Removes left and right occurrence of iChar characters of the given string.
     /// </summary>
     /// <param name="iStr">The string to trim.</param>
-    /// <param name="iChar">The character to remove.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
     /// <returns>Returns the trimmed string.</returns>
     std::string trim(const std::string & iStr, const char iChar);
 
@@ -168,7 +731,7 @@ namespace ra
     /// Removes right occurrence of iChar characters of the given string.
     /// </summary>
     /// <param name="iStr">The string to trim.</param>
-    /// <param name="iChar">The character to remove.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
     /// <returns>Returns the trimmed string.</returns>
     std::string trimRight(const std::string & iStr, const char iChar);
 
@@ -176,10 +739,100 @@ namespace ra
     /// Removes left occurrence of iChar characters of the given string.
     /// </summary>
     /// <param name="iStr">The string to trim.</param>
-    /// <param name="iChar">The character to remove.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
     /// <returns>Returns the trimmed string.</returns>
     std::string trimLeft(const std::string & iStr, const char iChar);
 
+    /// <summary>
+    /// Removes left and right occurrence of iChar characters of the given string without copying.
+    /// </summary>
+    /// <param name="iStr">The string to trim.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
+    /// <returns>Returns a StringRef within iStr which excludes the trimmed characters.</returns>
+    StringRef trimRef(const StringRef & iStr, const char iChar);
+
+    /// <summary>
+    /// Removes right occurrence of iChar characters of the given string without copying.
+    /// </summary>
+    /// <param name="iStr">The string to trim.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
+    /// <returns>Returns a StringRef within iStr which excludes the trimmed characters.</returns>
+    StringRef trimRightRef(const StringRef & iStr, const char iChar);
+
+    /// <summary>
+    /// Removes left occurrence of iChar characters of the given string without copying.
+    /// </summary>
+    /// <param name="iStr">The string to trim.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
+    /// <returns>Returns a StringRef within iStr which excludes the trimmed characters.</returns>
+    StringRef trimLeftRef(const StringRef & iStr, const char iChar);
+
+    /// <summary>
+    /// Removes left and right occurrence of any of the given characters without copying.
+    /// </summary>
+    /// <param name="iStr">The string to trim.</param>
+    /// <param name="iCharacters">The set of characters to remove. For instance " \t\r\n".</param>
+    /// <returns>Returns a StringRef within iStr which excludes the trimmed characters.</returns>
+    StringRef trimRef(const StringRef & iStr, const char * iCharacters);
+
+    /// <summary>
+    /// Removes right occurrence of any of the given characters without copying.
+    /// </summary>
+    /// <param name="iStr">The string to trim.</param>
+    /// <param name="iCharacters">The set of characters to remove. For instance " \t\r\n".</param>
+    /// <returns>Returns a StringRef within iStr which excludes the trimmed characters.</returns>
+    StringRef trimRightRef(const StringRef & iStr, const char * iCharacters);
+
+    /// <summary>
+    /// Removes left occurrence of any of the given characters without copying.
+    /// </summary>
+    /// <param name="iStr">The string to trim.</param>
+    /// <param name="iCharacters">The set of characters to remove. For instance " \t\r\n".</param>
+    /// <returns>Returns a StringRef within iStr which excludes the trimmed characters.</returns>
+    StringRef trimLeftRef(const StringRef & iStr, const char * iCharacters);
+
+    /// <summary>
+    /// Removes left and right occurrence of iChar characters of the given string in place.
+    /// </summary>
+    /// <param name="ioStr">The string to trim.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
+    void trimInPlace(std::string & ioStr, const char iChar);
+
+    /// <summary>
+    /// Removes right occurrence of iChar characters of the given string in place.
+    /// </summary>
+    /// <param name="ioStr">The string to trim.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
+    void trimRightInPlace(std::string & ioStr, const char iChar);
+
+    /// <summary>
+    /// Removes left occurrence of iChar characters of the given string in place.
+    /// </summary>
+    /// <param name="ioStr">The string to trim.</param>
+    /// <param name="iChar">The character to remove. A NULL character leaves the string unchanged.</param>
+    void trimLeftInPlace(std::string & ioStr, const char iChar);
+
+    /// <summary>
+    /// Removes left and right occurrence of any of the given characters in place.
+    /// </summary>
+    /// <param name="ioStr">The string to trim.</param>
+    /// <param name="iCharacters">The set of characters to remove. For instance " \t\r\n".</param>
+    void trimInPlace(std::string & ioStr, const char * iCharacters);
+
+    /// <summary>
+    /// Removes right occurrence of any of the given characters in place.
+    /// </summary>
+    /// <param name="ioStr">The string to trim.</param>
+    /// <param name="iCharacters">The set of characters to remove. For instance " \t\r\n".</param>
+    void trimRightInPlace(std::string & ioStr, const char * iCharacters);
+
+    /// <summary>
+    /// Removes left occurrence of any of the given characters in place.
+    /// </summary>
+    /// <param name="ioStr">The string to trim.</param>
+    /// <param name="iCharacters">The set of characters to remove. For instance " \t\r\n".</param>
+    void trimLeftInPlace(std::string & ioStr, const char * iCharacters);
+
     /// <summary>
     /// Reverse order each character of the given string.
     /// </summary>
@@ -188,11 +841,279 @@ namespace ra
     std::string reverse(const std::string & iStr);
 
     /// <summary>
-    /// Format a string.
+    /// Format a string. The output is never truncated.
+    /// </summary>
+    /// <param name="iFormat">The format of the string. Same as printf() format.</param>
+    /// <returns>Returns a formatted string with the given parameters inserted.</returns>
+    std::string format(const char * iFormat, ...) RA_PRINTF_FORMAT(1, 2);
+
+    /// <summary>
+    /// Format a string. The output is never truncated.
     /// </summary>
     /// <param name="iFormat">The format of the string. Same as printf() format.</param>
+    /// <param name="iArgs">The list of arguments matching the given format.</param>
     /// <returns>Returns a formatted string with the given parameters inserted.</returns>
-    std::string format(const char * iFormat, ...);
+    std::string vformat(const char * iFormat, va_list iArgs);
+
+    /// <summary>
+    /// Format a string and append the result to an existing string.
+    /// The formatted length is measured first which allows writing the output in place with at most one allocation.
+    /// </summary>
+    /// <param name="ioString">The destination string.</param>
+    /// <param name="iFormat">The format of the string. Same as printf() format.</param>
+    void appendFormat(std::string & ioString, const char * iFormat, ...) RA_PRINTF_FORMAT(2, 3);
+
+    /// <summary>
+    /// Format a string and append the result to an existing string.
+    /// The formatted length is measured first which allows writing the output in place with at most one allocation.
+    /// </summary>
+    /// <param name="ioString">The destination string.</param>
+    /// <param name="iFormat">The format of the string. Same as printf() format.</param>
+    /// <param name="iArgs">The list of arguments matching the given format.</param>
+    void vappendFormat(std::string & ioString, const char * iFormat, va_list iArgs);
+
+    /// <summary>
+    /// Builds a string by appending multiple values.
+    /// Small strings are built in an inline buffer without any memory allocation.
+    /// Larger strings grow geometrically and can be released to a std::string without copying the characters.
+    /// Numeric values are written directly in the builder's buffer. See toChars() for details.
+    /// </summary>
+    class StringBuilder
+    {
+    public:
+      /// <summary>
+      /// The number of characters (including the NULL terminating character) that can be stored without memory allocation.
+      /// </summary>
+      static const size_t INLINE_CAPACITY = 256;
+
+      StringBuilder();
+      StringBuilder(const StringBuilder & iOther);
+      StringBuilder & operator=(const StringBuilder & iOther);
+
+      /// <summary>
+      /// Creates an empty builder which can hold at least the given number of characters without reallocating.
+      /// </summary>
+      /// <param name="iCapacity">The expected number of characters.</param>
+      explicit StringBuilder(size_t iCapacity);
+
+      /// <summary>
+      /// Makes sure the builder can hold at least the given number of characters without reallocating.
+      /// </summary>
+      /// <param name="iCapacity">The expected number of characters.</param>
+      void reserve(size_t iCapacity);
+
+      /// <summary>
+      /// Removes all characters from the builder. The allocated memory is kept for reuse.
+      /// </summary>
+      void clear();
+
+      inline size_t size() const { return mSize; }
+      inline bool empty() const { return mSize == 0; }
+      inline size_t capacity() const { return mCapacity - 1; }
+      inline const char * data() const { return mData; }
+      inline const char * c_str() const { return mData; }
+
+      /// <summary>
+      /// Returns a copy of the characters of the builder.
+      /// </summary>
+      /// <returns>Returns a copy of the characters of the builder.</returns>
+      inline std::string toString() const { return std::string(mData, mSize); }
+
+      /// <summary>
+      /// Moves the characters of the builder to the given string and clears the builder.
+      /// When the characters are stored on the heap, the memory is handed off to oString without copying.
+      /// </summary>
+      /// <param name="oString">The output string.</param>
+      void release(std::string & oString);
+
+      StringBuilder & append(const char * iValue, size_t iSize);
+      StringBuilder & append(const char * iValue);
+      StringBuilder & append(const std::string & iValue);
+      StringBuilder & append(const StringRef & iValue);
+      StringBuilder & append(const char & iValue);
+      StringBuilder & append(const void * iValue);
+      StringBuilder & append(const int8_t   & iValue);
+      StringBuilder & append(const uint8_t  & iValue);
+      StringBuilder & append(const int16_t  & iValue);
+      StringBuilder & append(const uint16_t & iValue);
+      StringBuilder & append(const int32_t  & iValue);
+      StringBuilder & append(const uint32_t & iValue);
+      StringBuilder & append(const int64_t  & iValue);
+      StringBuilder & append(const uint64_t & iValue);
+      StringBuilder & append(const float    & iValue);
+      StringBuilder & append(const double   & iValue);
+
+      /// <summary>
+      /// Streams a value to the builder. See append() for the list of supported types.
+      /// </summary>
+      /// <param name="iValue">The value to append to the builder.</param>
+      /// <returns>Returns the builder.</returns>
+      template <class T>
+      inline StringBuilder & operator<<(const T & iValue) { return append(iValue); }
+
+    private:
+      //Makes sure iSize more characters (and a NULL terminating character) can be written. Returns the write position.
+      char * grow(size_t iSize);
+
+      template <class T>
+      StringBuilder & appendNumericT(const T & iValue);
+
+      char mInline[INLINE_CAPACITY];
+      std::string mHeap;  //storage used when the content does not fit in mInline
+      char * mData;       //either mInline or mHeap's characters
+      size_t mSize;
+      size_t mCapacity;   //including the NULL terminating character
+    };
+
+    /// <summary>
+    /// Matches strings against a compiled wildcard pattern.
+    /// The '*' character matches any sequence of characters (including an empty sequence).
+    /// The '?' character matches any single character.
+    /// A pattern is compiled once and can then be matched against any number of values.
+    /// Matching never backtracks: each segment between '*' characters is searched once, from left to right.
+    /// </summary>
+    class GlobMatcher
+    {
+    public:
+      GlobMatcher();
+
+      /// <summary>
+      /// Creates a matcher for the given wildcard pattern. See compile() for details.
+      /// </summary>
+      /// <param name="iPattern">The wildcard pattern.</param>
+      explicit GlobMatcher(const StringRef & iPattern);
+
+      /// <summary>
+      /// Compiles a single wildcard pattern. Only the '*' and '?' characters have a special meaning.
+      /// </summary>
+      /// <param name="iPattern">The wildcard pattern. For instance "*.txt".</param>
+      void compile(const StringRef & iPattern);
+
+      /// <summary>
+      /// Compiles a filter using the syntax of gtest's --gtest_filter command line option.
+      /// A filter is a list of ':' separated positive patterns, optionally followed by a '-' and a list of ':' separated negative patterns.
+      /// A value matches the filter if it matches any positive pattern and none of the negative patterns.
+      /// An empty list of positive patterns matches any value.
+      /// </summary>
+      /// <param name="iFilter">The filter. For instance "TestFoo.*:TestBar.*-*.testSlow*".</param>
+      void compileFilter(const StringRef & iFilter);
+
+      /// <summary>
+      /// Defines if the given value matches the compiled pattern.
+      /// </summary>
+      /// <param name="iValue">The value to match.</param>
+      /// <returns>Returns true if iValue matches the compiled pattern. Returns false otherwise.</returns>
+      bool match(const StringRef & iValue) const;
+
+    private:
+      //A sequence of literal or '?' characters delimited by '*' characters.
+      struct SEGMENT
+      {
+        size_t offset; //within mCharacters
+        size_t length;
+        bool hasWildcard; //true if the segment contains a '?' character
+      };
+
+      //A single wildcard pattern.
+      struct PATTERN
+      {
+        size_t firstSegment; //within mSegments
+        size_t numSegments;
+        bool anchoredStart; //the pattern does not start with '*'
+        bool anchoredEnd;   //the pattern does not end with '*'
+        bool negative;
+      };
+
+      void addPattern(const StringRef & iPattern, bool iNegative);
+      bool matchPattern(const PATTERN & iPattern, const StringRef & iValue) const;
+      bool matchSegment(const SEGMENT & iSegment, const char * iValue) const;
+      const char * findSegment(const SEGMENT & iSegment, const char * iFirst, const char * iLast) const;
+
+      std::string mCharacters;
+      std::vector<SEGMENT> mSegments;
+      std::vector<PATTERN> mPatterns;
+      bool mHasPositivePatterns;
+    };
+
+    /// <summary>
+    /// Defines if the given value matches a wildcard pattern. See GlobMatcher for details.
+    /// Use a GlobMatcher to match multiple values against the same pattern.
+    /// </summary>
+    /// <param name="iPattern">The wildcard pattern. For instance "*.txt".</param>
+    /// <param name="iValue">The value to match.</param>
+    /// <returns>Returns true if iValue matches iPattern. Returns false otherwise.</returns>
+    bool globMatch(const StringRef & iPattern, const StringRef & iValue);
+
+    /// <summary>
+    /// A thread-safe pool of unique strings.
+    /// Each distinct string is stored once in an arena and is identified by a compact ID.
+    /// Two interned strings are equal if and only if their IDs are equal.
+    /// Interned strings are never moved: references returned by get() stay valid until the pool is cleared or destroyed.
+    /// </summary>
+    class StringPool
+    {
+    public:
+      typedef uint32_t ID;
+      static const ID INVALID_ID = 0xFFFFFFFF;
+
+      StringPool();
+      ~StringPool();
+
+      /// <summary>
+      /// Adds a string to the pool if not already present.
+      /// </summary>
+      /// <param name="iValue">The string to add.</param>
+      /// <returns>Returns the ID of the string within the pool.</returns>
+      ID intern(const StringRef & iValue);
+
+      /// <summary>
+      /// Finds a string in the pool without adding it.
+      /// </summary>
+      /// <param name="iValue">The string to find.</param>
+      /// <returns>Returns the ID of the string within the pool. Returns INVALID_ID if the string is not in the pool.</returns>
+      ID find(const StringRef & iValue) const;
+
+      /// <summary>
+      /// Returns the string matching the given ID. The returned string is NULL terminated.
+      /// </summary>
+      /// <param name="iId">A valid ID returned by intern().</param>
+      /// <returns>Returns the string matching the given ID. Returns an empty StringRef if iId is invalid.</returns>
+      StringRef get(ID iId) const;
+
+      /// <summary>
+      /// Returns the number of unique strings in the pool.
+      /// </summary>
+      size_t size() const;
+
+      /// <summary>
+      /// Removes all strings from the pool. All previously returned IDs and references become invalid.
+      /// </summary>
+      void clear();
+
+    private:
+      //disable copy
+      StringPool(const StringPool &);
+      StringPool & operator=(const StringPool &);
+
+      struct ENTRY
+      {
+        const char * data;
+        size_t size;
+        uint64_t hash;
+      };
+
+      ID findLocked(const StringRef & iValue, uint64_t iHash, size_t & oBucket) const;
+      const char * allocate(const StringRef & iValue);
+      void rehash(size_t iBucketCount);
+      void release();
+
+      std::vector<char *> mBlocks;  //arena of all characters
+      char * mBlock;                //current arena block
+      size_t mBlockSize;            //number of used characters in the current block
+      std::vector<ENTRY> mEntries;  //indexed by ID
+      std::vector<ID> mBuckets;     //open addressing hash table of IDs
+      void * mMutex;
+    };
 
   } //namespace strings
 } //namespace ra
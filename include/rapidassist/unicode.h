@@ -0,0 +1,105 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef RA_UNICODE_H
+#define RA_UNICODE_H
+
+#include <stdint.h>
+#include <stddef.h> //for size_t
+#include <string>
+#include <vector>
+
+namespace ra
+{
+  namespace unicode
+  {
+    typedef std::vector<uint16_t> Utf16Vector;
+    typedef std::vector<uint32_t> Utf32Vector;
+
+    /// <summary>
+    /// Defines if the given buffer is a valid UTF-8 encoded string.
+    /// Overlong encodings, surrogates and code points above U+10FFFF are invalid.
+    /// ASCII characters are validated 16 at a time.
+    /// </summary>
+    /// <param name="iBuffer">The buffer to validate.</param>
+    /// <param name="iSize">The size in bytes of the buffer.</param>
+    /// <returns>Returns true if the buffer is valid UTF-8. Returns false otherwise.</returns>
+    bool isValidUtf8(const char * iBuffer, size_t iSize);
+
+    /// <summary>
+    /// Defines if the given string is a valid UTF-8 encoded string.
+    /// </summary>
+    /// <param name="iValue">The string to validate.</param>
+    /// <returns>Returns true if the string is valid UTF-8. Returns false otherwise.</returns>
+    bool isValidUtf8(const std::string & iValue);
+
+    /// <summary>
+    /// Counts the number of code points of a valid UTF-8 encoded string.
+    /// The buffer is not validated. See isValidUtf8().
+    /// </summary>
+    /// <param name="iBuffer">A valid UTF-8 buffer.</param>
+    /// <param name="iSize">The size in bytes of the buffer.</param>
+    /// <returns>Returns the number of code points in the buffer.</returns>
+    size_t countCodePoints(const char * iBuffer, size_t iSize);
+
+    /// <summary>
+    /// Converts a UTF-8 encoded string to UTF-16.
+    /// </summary>
+    /// <param name="iBuffer">The UTF-8 buffer to convert.</param>
+    /// <param name="iSize">The size in bytes of the buffer.</param>
+    /// <param name="oUtf16">The converted UTF-16 code units, without byte order mark. Empty if the conversion failed.</param>
+    /// <returns>Returns true if the buffer is valid UTF-8. Returns false otherwise.</returns>
+    bool utf8ToUtf16(const char * iBuffer, size_t iSize, Utf16Vector & oUtf16);
+
+    /// <summary>
+    /// Converts a UTF-8 encoded string to UTF-32.
+    /// </summary>
+    /// <param name="iBuffer">The UTF-8 buffer to convert.</param>
+    /// <param name="iSize">The size in bytes of the buffer.</param>
+    /// <param name="oUtf32">The converted code points. Empty if the conversion failed.</param>
+    /// <returns>Returns true if the buffer is valid UTF-8. Returns false otherwise.</returns>
+    bool utf8ToUtf32(const char * iBuffer, size_t iSize, Utf32Vector & oUtf32);
+
+    /// <summary>
+    /// Converts a UTF-16 encoded string to UTF-8.
+    /// </summary>
+    /// <param name="iBuffer">The UTF-16 code units to convert.</param>
+    /// <param name="iCount">The number of code units in the buffer.</param>
+    /// <param name="oUtf8">The converted UTF-8 string. Empty if the conversion failed.</param>
+    /// <returns>Returns true if the buffer is valid UTF-16. Returns false if the buffer contains an unpaired surrogate.</returns>
+    bool utf16ToUtf8(const uint16_t * iBuffer, size_t iCount, std::string & oUtf8);
+
+    /// <summary>
+    /// Converts a UTF-32 encoded string to UTF-8.
+    /// </summary>
+    /// <param name="iBuffer">The code points to convert.</param>
+    /// <param name="iCount">The number of code points in the buffer.</param>
+    /// <param name="oUtf8">The converted UTF-8 string. Empty if the conversion failed.</param>
+    /// <returns>Returns true if all code points are valid. Returns false if the buffer contains a surrogate or a value above U+10FFFF.</returns>
+    bool utf32ToUtf8(const uint32_t * iBuffer, size_t iCount, std::string & oUtf8);
+
+  } //namespace unicode
+} //namespace ra
+
+#endif //RA_UNICODE_H
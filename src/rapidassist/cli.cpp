@@ -23,8 +23,9 @@
  *********************************************************************************/
 
 #include "rapidassist/cli.h"
-#include <cstdlib> //for atoi()
-#include <cstdio> //for sscanf()
+#include "rapidassist/strings.h"
+
+#include <limits> //for std::numeric_limits
 
 namespace ra
 {
@@ -72,7 +73,13 @@ namespace ra
       bool found = parseArgument(name, tmp, argc, argv);
       if (found)
       {
-        value = atoi(tmp.c_str());
+        const char * first = tmp.c_str();
+        const char * last = first + tmp.size();
+        int32_t parsed = 0;
+        ra::strings::FROMCHARS_RESULT result = ra::strings::fromChars(first, last, parsed);
+        if (result.error != ra::strings::FROMCHARS_SUCCESS || result.ptr != last)
+          return false;
+        value = parsed;
         return true;
       }
       return false;
@@ -84,19 +91,16 @@ namespace ra
       bool found = parseArgument(name, tmp, argc, argv);
       if (found)
       {
-#ifdef _WIN32
-        static const char * format = "%Iu";
-#elif __linux__
-        static const char * format = "%zu";
-#endif
-        if (1 == sscanf(tmp.c_str(), format, &value))
-        {
-          return true;
-        }
-        else
-        {
+        const char * first = tmp.c_str();
+        const char * last = first + tmp.size();
+        uint64_t parsed = 0;
+        ra::strings::FROMCHARS_RESULT result = ra::strings::fromChars(first, last, parsed);
+        if (result.error != ra::strings::FROMCHARS_SUCCESS || result.ptr != last)
           return false;
-        }
+        if (parsed > (uint64_t)std::numeric_limits<size_t>::max())
+          return false;
+        value = (size_t)parsed;
+        return true;
       }
       return false;
     }
@@ -23,12 +23,20 @@
  *********************************************************************************/
 
 #include "rapidassist/cppencoder.h"
+#include "rapidassist/strings.h"
+#include "parallel.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h> //for memcpy()
 #include <string>
-#include <stdlib.h>
-#include <sstream>
+#include <vector>
+#include <stdint.h> //for uint32_t, uint64_t
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RA_CPPENCODER_SSE2
+#include <emmintrin.h> //for SSE2 intrinsics
+#endif
 
 //http://stackoverflow.com/questions/10057258/how-does-x-work-in-a-string
 //http://en.cppreference.com/w/cpp/language/escape
@@ -59,230 +67,1453 @@ namespace ra
       {'\\',"\\\\"},  //0x5C
     };
     static const size_t gNumCtrlChars = sizeof(gCtrlChars)/sizeof(gCtrlChars[0]);
+    static const size_t OCT_ESCAPE_LENGTH = 4; //ie \377
+    static const size_t HEX_ESCAPE_LENGTH = 4; //ie \xff
+
+    static const char * gHexDigits = "0123456789abcdef";
+
+    enum CHARACTER_FLAGS
+    {
+      FLAG_PRINTABLE  = 0x01,
+      FLAG_CONTROL    = 0x02,
+      FLAG_DIGIT      = 0x04,
+      FLAG_HEX        = 0x08,
+    };
+
+    //Character classes of the string literal decoder
+    enum DECODE_CLASS
+    {
+      CLASS_CHARACTER,    //any character without a special meaning
+      CLASS_BACKSLASH,    //'\\'
+      CLASS_QUOTE,        //'"', must be escaped in a string literal
+      CLASS_OCT_DIGIT,    //'0' to '7'
+      CLASS_DEC_DIGIT,    //'8' and '9'
+      CLASS_HEX_ESCAPE,   //'a', 'b' and 'f': hexadecimal digits which are also escape sequences
+      CLASS_HEX_LETTER,   //other hexadecimal letters
+      CLASS_X,            //'x'
+      CLASS_ESCAPE,       //other escape sequences characters: 'n', 'r', 't', 'v', '\'' and '?'
+      NUM_DECODE_CLASSES
+    };
+
+    struct CHARACTER_INFO
+    {
+      unsigned char flags;
+      const char * escapeStr;                 //control character escape sequence. NULL if not a control character.
+      char octString[OCT_ESCAPE_LENGTH + 1];  //NULL terminated octal escape sequence
+      char hexString[HEX_ESCAPE_LENGTH + 1];  //NULL terminated hexadecimal escape sequence
+      unsigned char decodeClass;              //class of the character for the string literal decoder
+      unsigned char digitValue;               //value of an hexadecimal digit
+      unsigned char escapeValue;              //value of the escape sequence made of '\\' and this character
+    };
+
+    //Encoding of a character in a given state of an encoder.
+    //The text is padded to 4 bytes so that it can always be copied as a whole.
+    static const size_t MAX_ENCODING_LENGTH = 4;
+    struct ENCODING
+    {
+      char text[MAX_ENCODING_LENGTH];
+      unsigned char length;
+      unsigned char nextState;
+    };
+
+    //States of the string literal encoders: defines if the previous character was encoded as an escape sequence
+    //which could be extended by the next character (ie "\1" followed by '2' or "\xf" followed by 'a').
+    enum ENCODER_STATE
+    {
+      STATE_DEFAULT = 0,
+      STATE_ESCAPE_SEQUENCE = 1,
+      NUM_STATES
+    };
+    typedef ENCODING STATE_ENCODINGS[NUM_STATES][256]; //[state][character]
+
+    //Classification and encodings of all byte values.
+    //The table is built once when the library is loaded and is read-only afterward.
+    class CharacterTable
+    {
+    public:
+      CharacterTable()
+      {
+        for(size_t i=0; i<256; i++)
+        {
+          const unsigned char c = (unsigned char)i;
+          CHARACTER_INFO & info = mCharacters[c];
+          info.flags = 0;
+          if (c >= 32 && c <= 126 && c != '\'' && c != '\\')
+            info.flags |= FLAG_PRINTABLE;
+          if (c >= '0' && c <= '9')
+            info.flags |= FLAG_DIGIT | FLAG_HEX;
+          if ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
+            info.flags |= FLAG_HEX;
+
+          info.escapeStr = NULL;
+          for(size_t j=0; j<gNumCtrlChars; j++)
+          {
+            if ((unsigned char)gCtrlChars[j].c == c)
+            {
+              info.flags |= FLAG_CONTROL;
+              info.escapeStr = gCtrlChars[j].escapeStr;
+            }
+          }
+
+          ENCODING escape;
+          setOctEncoding(escape, c);
+          memcpy(info.octString, escape.text, OCT_ESCAPE_LENGTH);
+          info.octString[OCT_ESCAPE_LENGTH] = '\0';
+          setHexEncoding(escape, c);
+          memcpy(info.hexString, escape.text, HEX_ESCAPE_LENGTH);
+          info.hexString[HEX_ESCAPE_LENGTH] = '\0';
+
+          info.digitValue = 0;
+          if (c >= '0' && c <= '9')
+            info.digitValue = (unsigned char)(c - '0');
+          else if (c >= 'a' && c <= 'f')
+            info.digitValue = (unsigned char)(c - 'a' + 10);
+          else if (c >= 'A' && c <= 'F')
+            info.digitValue = (unsigned char)(c - 'A' + 10);
+
+          info.escapeValue = 0;
+          for(size_t j=0; j<gNumCtrlChars; j++)
+          {
+            if ((unsigned char)gCtrlChars[j].escapeStr[1] == c)
+              info.escapeValue = (unsigned char)gCtrlChars[j].c;
+          }
+
+          if (c == '\\')
+            info.decodeClass = CLASS_BACKSLASH;
+          else if (c == '"')
+            info.decodeClass = CLASS_QUOTE;
+          else if (c >= '0' && c <= '7')
+            info.decodeClass = CLASS_OCT_DIGIT;
+          else if (c == '8' || c == '9')
+            info.decodeClass = CLASS_DEC_DIGIT;
+          else if (c == 'a' || c == 'b' || c == 'f')
+            info.decodeClass = CLASS_HEX_ESCAPE;
+          else if (info.flags & FLAG_HEX)
+            info.decodeClass = CLASS_HEX_LETTER;
+          else if (c == 'x')
+            info.decodeClass = CLASS_X;
+          else if (c == 'n' || c == 'r' || c == 't' || c == 'v' || c == '\'' || c == '?')
+            info.decodeClass = CLASS_ESCAPE;
+          else
+            info.decodeClass = CLASS_CHARACTER;
+        }
+
+        for(size_t i=0; i<256; i++)
+        {
+          const unsigned char c = (unsigned char)i;
+          const CHARACTER_INFO & info = mCharacters[c];
+
+          //toOctString()
+          for(size_t disableWarningC4125 = 0; disableWarningC4125 < 2; disableWarningC4125++)
+          {
+            for(size_t state = 0; state < NUM_STATES; state++)
+            {
+              ENCODING & encoding = mOctEncodings[disableWarningC4125][state][c];
+              if (c == 0)
+                setEncoding(encoding, info.escapeStr, STATE_ESCAPE_SEQUENCE); //safe to encode NULL character as '\0' if not followed by a digit
+              else if (info.flags & FLAG_CONTROL)
+                setEncoding(encoding, info.escapeStr, STATE_DEFAULT);
+              else if ((info.flags & FLAG_PRINTABLE) && !(disableWarningC4125 && state == STATE_ESCAPE_SEQUENCE && (info.flags & FLAG_DIGIT)))
+                setEncoding(encoding, c, STATE_DEFAULT); //a digit following an octal escape sequence generates warning C4125 (decimal digit terminates octal escape sequence)
+              else
+                setOctEncoding(encoding, c);
+            }
+          }
+
+          //toHexString()
+          for(size_t state = 0; state < NUM_STATES; state++)
+          {
+            ENCODING & encoding = mHexEncodings[state][c];
+            if (info.flags & FLAG_CONTROL)
+              setEncoding(encoding, info.escapeStr, STATE_DEFAULT); //safe to encode NULL character as '\0' if not followed by a digit
+            else if ((info.flags & FLAG_PRINTABLE) && !(state == STATE_ESCAPE_SEQUENCE && (info.flags & FLAG_HEX)))
+              setEncoding(encoding, c, STATE_DEFAULT); //an hexadecimal letter cannot follow an hexadecimal escape sequence.
+            else
+              setHexEncoding(encoding, c);
+          }
+
+          //toCppCharactersArray(), each value is followed by a separator
+          ENCODING & encoding = mArrayEncodings[c];
+          encoding.length = 0;
+          encoding.nextState = STATE_DEFAULT;
+          if (info.flags & FLAG_PRINTABLE)
+          {
+            encoding.text[encoding.length++] = '\'';
+            encoding.text[encoding.length++] = (char)c;
+            encoding.text[encoding.length++] = '\'';
+          }
+          else
+          {
+            //print as decimal value
+            if (c >= 100)
+              encoding.text[encoding.length++] = (char)('0' + c / 100);
+            if (c >= 10)
+              encoding.text[encoding.length++] = (char)('0' + (c / 10) % 10);
+            encoding.text[encoding.length++] = (char)('0' + c % 10);
+          }
+          encoding.text[encoding.length++] = ',';
+        }
+
+        //NULL character followed by a digit must be encoded with all its digits
+        setOctEncoding(mOctNullBeforeDigit, 0);
+        setHexEncoding(mHexNullBeforeDigit, 0);
+      }
+
+      inline const CHARACTER_INFO & operator[](unsigned char c) const
+      {
+        return mCharacters[c];
+      }
+
+      inline const STATE_ENCODINGS & getOctEncodings(bool iDisableWarningC4125) const
+      {
+        return mOctEncodings[iDisableWarningC4125 ? 1 : 0];
+      }
+
+      inline const STATE_ENCODINGS & getHexEncodings() const
+      {
+        return mHexEncodings;
+      }
+
+      inline const ENCODING * getArrayEncodings() const
+      {
+        return mArrayEncodings;
+      }
+
+      inline const ENCODING & getOctNullBeforeDigit() const { return mOctNullBeforeDigit; }
+      inline const ENCODING & getHexNullBeforeDigit() const { return mHexNullBeforeDigit; }
+
+    private:
+      static void setEncoding(ENCODING & oEncoding, const char * iText, ENCODER_STATE iNextState)
+      {
+        oEncoding.length = 0;
+        for(const char * p = iText; *p != '\0'; p++)
+          oEncoding.text[oEncoding.length++] = *p;
+        oEncoding.nextState = (unsigned char)iNextState;
+      }
+
+      static void setEncoding(ENCODING & oEncoding, unsigned char c, ENCODER_STATE iNextState)
+      {
+        oEncoding.text[0] = (char)c;
+        oEncoding.length = 1;
+        oEncoding.nextState = (unsigned char)iNextState;
+      }
+
+      static void setOctEncoding(ENCODING & oEncoding, unsigned char c)
+      {
+        oEncoding.text[0] = '\\';
+        oEncoding.text[1] = (char)('0' + (c / 64));
+        oEncoding.text[2] = (char)('0' + (c / 8) % 8);
+        oEncoding.text[3] = (char)('0' + (c % 8));
+        oEncoding.length = OCT_ESCAPE_LENGTH;
+        oEncoding.nextState = STATE_ESCAPE_SEQUENCE;
+      }
+
+      static void setHexEncoding(ENCODING & oEncoding, unsigned char c)
+      {
+        oEncoding.text[0] = '\\';
+        oEncoding.text[1] = 'x';
+        oEncoding.text[2] = gHexDigits[c / 16];
+        oEncoding.text[3] = gHexDigits[c % 16];
+        oEncoding.length = HEX_ESCAPE_LENGTH;
+        oEncoding.nextState = STATE_ESCAPE_SEQUENCE;
+      }
+
+      CHARACTER_INFO mCharacters[256];
+      STATE_ENCODINGS mOctEncodings[2]; //[iDisableWarningC4125]
+      STATE_ENCODINGS mHexEncodings;
+      ENCODING mArrayEncodings[256];
+      ENCODING mOctNullBeforeDigit;
+      ENCODING mHexNullBeforeDigit;
+    };
+    static const CharacterTable gCharacterTable;
+
+    //Computes the size of an encoded string without writing it.
+    struct SIZE_COUNTER
+    {
+      size_t size;
+
+      SIZE_COUNTER() : size(0) {}
+      inline void append(const ENCODING & iEncoding) { size += iEncoding.length; }
+      inline void append(const char * /*iValue*/, size_t iLength) { size += iLength; }
+    };
+
+    //Writes an encoded string to a buffer which is known to be large enough.
+    //The buffer must have MAX_ENCODING_LENGTH-1 extra bytes since encodings are always copied as a whole.
+    struct BUFFER_WRITER
+    {
+      char * position;
+
+      BUFFER_WRITER(char * iBuffer) : position(iBuffer) {}
+      inline void append(const ENCODING & iEncoding)
+      {
+        memcpy(position, iEncoding.text, MAX_ENCODING_LENGTH);
+        position += iEncoding.length;
+      }
+      inline void append(const char * iValue, size_t iLength)
+      {
+        memcpy(position, iValue, iLength);
+        position += iLength;
+      }
+    };
+
+    //Runs the given encoder once to compute the exact size of the output and a second time to write the output.
+    template <typename ENCODER>
+    inline std::string encodeTwoPass(const ENCODER & iEncoder)
+    {
+      std::string output;
+      SIZE_COUNTER counter;
+      iEncoder.encode(counter);
+      if (counter.size == 0)
+        return output;
+      output.resize(counter.size + MAX_ENCODING_LENGTH - 1);
+      BUFFER_WRITER writer(&output[0]);
+      iEncoder.encode(writer);
+      output.resize(counter.size);
+      return output;
+    }
 
     bool isPrintableCharacter(const char c)
     {
-      if (c == 39) // character ' must be escaped with \' which is not supported right now
-        return false;
-      if (c == 92) // character \ must be escaped with \\ which is not supported right now
-        return false;
-      if (c >= 32 && c<= 126)
-        return true;
-      return false;
+      return (gCharacterTable[(unsigned char)c].flags & FLAG_PRINTABLE) != 0;
     }
 
     bool isControlCharacter(char c)
     {
-      for(size_t i=0; i<gNumCtrlChars; i++)
-      {
-        const CONTROL_CHARACTER & ctrl = gCtrlChars[i];
-        if (ctrl.c == c)
-          return true;
-      }
-      return false;
+      return (gCharacterTable[(unsigned char)c].flags & FLAG_CONTROL) != 0;
     }
 
     bool isHexCharacter(char c)
     {
-      if (c >= '0' && c <= '9')
-        return true;
-      if (c >= 'a' && c <= 'f')
-        return true;
-      if (c >= 'A' && c <= 'F')
-        return true;
-      return false;
+      return (gCharacterTable[(unsigned char)c].flags & FLAG_HEX) != 0;
     }
 
     bool isDigitCharacter(char c)
     {
-      if (c >= '0' && c <= '9')
-        return true;
-      return false;
+      return (gCharacterTable[(unsigned char)c].flags & FLAG_DIGIT) != 0;
     }
 
     const char * getControlCharacterEscapeString(char c)
     {
-      for(size_t i=0; i<gNumCtrlChars; i++)
-      {
-        const CONTROL_CHARACTER & ctrl = gCtrlChars[i];
-        if (ctrl.c == c)
-          return ctrl.escapeStr;
-      }
-      return NULL;
+      return gCharacterTable[(unsigned char)c].escapeStr;
     }
 
     const char * toOctString(unsigned char c)
     {
-      static char buffer[] = {'\\', '9', '9', '9', '\0'};
-      static const char * octCharacters = "01234567";
-      buffer[3] = octCharacters[c%8];
-      c /= 8;
-      buffer[2] = octCharacters[c%8];
-      c /= 8;
-      buffer[1] = octCharacters[c];
-      return buffer;
+      return gCharacterTable[c].octString;
     }
 
     const char * toHexString(unsigned char c)
     {
-      static char buffer[] = {'\\', 'x', 'f', 'f', '\0'};
-      static const char * hexCharacters = "0123456789abcdef";
-      buffer[3] = hexCharacters[c%16];
-      c /= 16;
-      buffer[2] = hexCharacters[c];
-      return buffer;
+      return gCharacterTable[c].hexString;
     }
 
+    //Returns the encoding of character iIndex of a string literal in the given state.
+    inline const ENCODING & getStringLiteralEncoding(const STATE_ENCODINGS & iEncodings, const ENCODING & iNullBeforeDigit, const unsigned char * iBuffer, size_t iIndex, size_t iSize, size_t iState)
+    {
+      const unsigned char c = iBuffer[iIndex];
+      if (c == 0 && iIndex + 1 < iSize && (gCharacterTable[iBuffer[iIndex + 1]].flags & FLAG_DIGIT))
+        return iNullBeforeDigit;
+      return iEncodings[iState][c];
+    }
+
+    //Encodes iCount characters of a string literal using the given state machine, starting from state iState.
+    //iSize characters of the buffer are readable: the character following the last encoded character, if any,
+    //is used to select the encoding of a NULL character. A NULL character followed by a digit uses iNullBeforeDigit.
+    //Returns the state of the state machine after the last encoded character.
+    template <typename WRITER>
+    inline size_t encodeStringLiteral(const STATE_ENCODINGS & iEncodings, const ENCODING & iNullBeforeDigit, const unsigned char * iBuffer, size_t iCount, size_t iSize, size_t iState, WRITER & ioWriter)
+    {
+      size_t state = iState;
+      for(size_t i=0; i<iCount; i++)
+      {
+        const ENCODING & encoding = getStringLiteralEncoding(iEncodings, iNullBeforeDigit, iBuffer, i, iSize, state);
+        ioWriter.append(encoding);
+        state = encoding.nextState;
+      }
+      return state;
+    }
+
+    //Encodes iCount characters as an array of values. Each value is followed by a separator.
+    template <typename WRITER>
+    inline void encodeCharactersArray(const unsigned char * iBuffer, size_t iCount, WRITER & ioWriter)
+    {
+      const ENCODING * encodings = gCharacterTable.getArrayEncodings();
+      for(size_t i=0; i<iCount; i++)
+      {
+        ioWriter.append(encodings[iBuffer[i]]);
+      }
+    }
+
+    struct STRING_LITERAL_ENCODER
+    {
+      const STATE_ENCODINGS & encodings;
+      const ENCODING & nullBeforeDigit;
+      const unsigned char * buffer;
+      size_t size;
+
+      template <typename WRITER>
+      inline void encode(WRITER & ioWriter) const
+      {
+        encodeStringLiteral(encodings, nullBeforeDigit, buffer, size, size, STATE_DEFAULT, ioWriter);
+      }
+    };
+
+    struct CPP_CHARACTERS_ARRAY_ENCODER
+    {
+      const unsigned char * buffer;
+      size_t size;
+
+      template <typename WRITER>
+      inline void encode(WRITER & ioWriter) const
+      {
+        encodeCharactersArray(buffer, size, ioWriter);
+      }
+    };
+
     std::string toOctString(const unsigned char * iBuffer, size_t iSize)
     {
       return toOctString(iBuffer, iSize, true);
     }
 
     std::string toOctString(const unsigned char * iBuffer, size_t iSize, bool iDisableWarningC4125)
+    {
+      STRING_LITERAL_ENCODER encoder = {gCharacterTable.getOctEncodings(iDisableWarningC4125), gCharacterTable.getOctNullBeforeDigit(), iBuffer, iSize};
+      return encodeTwoPass(encoder);
+    }
+
+    std::string toHexString(const unsigned char * iBuffer, size_t iSize)
+    {
+      STRING_LITERAL_ENCODER encoder = {gCharacterTable.getHexEncodings(), gCharacterTable.getHexNullBeforeDigit(), iBuffer, iSize};
+      return encodeTwoPass(encoder);
+    }
+
+    std::string toCppCharactersArray(const unsigned char * iBuffer, size_t iSize)
+    {
+      CPP_CHARACTERS_ARRAY_ENCODER encoder = {iBuffer, iSize};
+      std::string output = encodeTwoPass(encoder);
+      if (!output.empty())
+        output.resize(output.size() - 1); //remove the last separator
+      return output;
+    }
+
+    //Writes an encoded string to a buffer without writing past the end of the last encoding.
+    struct EXACT_BUFFER_WRITER
+    {
+      char * position;
+
+      EXACT_BUFFER_WRITER(char * iBuffer) : position(iBuffer) {}
+      inline void append(const ENCODING & iEncoding)
+      {
+        memcpy(position, iEncoding.text, iEncoding.length);
+        position += iEncoding.length;
+      }
+    };
+
+    //Minimum number of bytes encoded by each thread of the parallel encoders.
+    static const size_t PARALLEL_ENCODE_MIN_CHUNK_SIZE = 256 * 1024;
+
+    //A partition of the input buffer encoded by a thread of the parallel encoders.
+    struct ENCODE_CHUNK
+    {
+      const unsigned char * buffer;
+      size_t count;     //number of characters to encode
+      size_t available; //number of readable characters from buffer, including the following chunks
+      const STATE_ENCODINGS * encodings; //NULL for an array of characters
+      const ENCODING * nullBeforeDigit;
+
+      //first pass: encoded size and final state for each possible initial state
+      size_t sizes[NUM_STATES];
+      size_t endStates[NUM_STATES];
+
+      //second pass
+      size_t startState;
+      char * output;
+    };
+
+    //Computes the encoded size of a chunk for each possible initial state since the state at the
+    //end of the previous chunk is not known yet. Both state machines usually converge after a few
+    //characters, after which a single one is run.
+    void countChunk(void * iChunk)
+    {
+      ENCODE_CHUNK & chunk = *(ENCODE_CHUNK *)iChunk;
+      if (chunk.encodings == NULL)
+      {
+        SIZE_COUNTER counter;
+        encodeCharactersArray(chunk.buffer, chunk.count, counter);
+        for(size_t s = 0; s < NUM_STATES; s++)
+        {
+          chunk.sizes[s] = counter.size;
+          chunk.endStates[s] = STATE_DEFAULT;
+        }
+        return;
+      }
+
+      size_t states[NUM_STATES];
+      for(size_t s = 0; s < NUM_STATES; s++)
+      {
+        states[s] = s;
+        chunk.sizes[s] = 0;
+      }
+      size_t i = 0;
+      for(; i < chunk.count && states[STATE_DEFAULT] != states[STATE_ESCAPE_SEQUENCE]; i++)
+      {
+        for(size_t s = 0; s < NUM_STATES; s++)
+        {
+          const ENCODING & encoding = getStringLiteralEncoding(*chunk.encodings, *chunk.nullBeforeDigit, chunk.buffer, i, chunk.available, states[s]);
+          chunk.sizes[s] += encoding.length;
+          states[s] = encoding.nextState;
+        }
+      }
+
+      //encode the remaining characters from the common state
+      SIZE_COUNTER counter;
+      const size_t endState = encodeStringLiteral(*chunk.encodings, *chunk.nullBeforeDigit, chunk.buffer + i, chunk.count - i, chunk.available - i, states[STATE_DEFAULT], counter);
+      for(size_t s = 0; s < NUM_STATES; s++)
+      {
+        chunk.sizes[s] += counter.size;
+        chunk.endStates[s] = (i < chunk.count ? endState : states[s]);
+      }
+    }
+
+    //Writes the encoded chunk to its position in the output.
+    //The last characters are written exactly to not overwrite the output of the next chunk.
+    void writeChunk(void * iChunk)
+    {
+      ENCODE_CHUNK & chunk = *(ENCODE_CHUNK *)iChunk;
+      const size_t exactCount = (chunk.count < MAX_ENCODING_LENGTH - 1 ? chunk.count : MAX_ENCODING_LENGTH - 1);
+      const size_t count = chunk.count - exactCount;
+      BUFFER_WRITER writer(chunk.output);
+      if (chunk.encodings == NULL)
+      {
+        encodeCharactersArray(chunk.buffer, count, writer);
+        EXACT_BUFFER_WRITER exactWriter(writer.position);
+        encodeCharactersArray(chunk.buffer + count, exactCount, exactWriter);
+      }
+      else
+      {
+        const size_t state = encodeStringLiteral(*chunk.encodings, *chunk.nullBeforeDigit, chunk.buffer, count, chunk.available, chunk.startState, writer);
+        EXACT_BUFFER_WRITER exactWriter(writer.position);
+        encodeStringLiteral(*chunk.encodings, *chunk.nullBeforeDigit, chunk.buffer + count, exactCount, chunk.available - count, state, exactWriter);
+      }
+    }
+
+    //Encodes iBuffer concurrently. Returns false if the buffer must be encoded on the calling thread.
+    bool encodeParallel(std::string & oOutput, const unsigned char * iBuffer, size_t iSize, const STATE_ENCODINGS * iEncodings, const ENCODING * iNullBeforeDigit, size_t iNumThreads)
+    {
+      if (iNumThreads == 0)
+        iNumThreads = ra::parallel::getNumProcessors();
+      size_t numChunks = iSize / PARALLEL_ENCODE_MIN_CHUNK_SIZE;
+      if (numChunks > iNumThreads)
+        numChunks = iNumThreads;
+      if (numChunks <= 1)
+        return false;
+
+      std::vector<ENCODE_CHUNK> chunks(numChunks);
+      std::vector<void *> tasks(numChunks);
+      const size_t chunkSize = iSize / numChunks;
+      for(size_t i=0; i<numChunks; i++)
+      {
+        ENCODE_CHUNK & chunk = chunks[i];
+        const size_t offset = chunkSize * i;
+        chunk.buffer = iBuffer + offset;
+        chunk.count = (i + 1 == numChunks ? iSize - offset : chunkSize);
+        chunk.available = iSize - offset;
+        chunk.encodings = iEncodings;
+        chunk.nullBeforeDigit = iNullBeforeDigit;
+        chunk.startState = STATE_DEFAULT;
+        chunk.output = NULL;
+        tasks[i] = &chunk;
+      }
+      ra::parallel::runTasks(&countChunk, &tasks[0], tasks.size());
+
+      //resolve the initial state and the output position of each chunk
+      std::vector<size_t> offsets(numChunks);
+      size_t state = STATE_DEFAULT;
+      size_t size = 0;
+      for(size_t i=0; i<numChunks; i++)
+      {
+        ENCODE_CHUNK & chunk = chunks[i];
+        chunk.startState = state;
+        offsets[i] = size;
+        size += chunk.sizes[state];
+        state = chunk.endStates[state];
+      }
+
+      oOutput.resize(size);
+      for(size_t i=0; i<numChunks; i++)
+      {
+        chunks[i].output = &oOutput[0] + offsets[i];
+      }
+      ra::parallel::runTasks(&writeChunk, &tasks[0], tasks.size());
+      return true;
+    }
+
+    std::string toOctStringParallel(const unsigned char * iBuffer, size_t iSize, bool iDisableWarningC4125, size_t iNumThreads)
     {
       std::string output;
+      if (!encodeParallel(output, iBuffer, iSize, &gCharacterTable.getOctEncodings(iDisableWarningC4125), &gCharacterTable.getOctNullBeforeDigit(), iNumThreads))
+        return toOctString(iBuffer, iSize, iDisableWarningC4125);
+      return output;
+    }
 
-      //estimate the size of the output string to prevent memory copy
-      //assume 50% of buffer is *NOT* printable
-      size_t nonPrintableSize = ((iSize*50)/100);
-      size_t estimatedStringSize = iSize - nonPrintableSize + nonPrintableSize*4; //4 bytes per octal characters
-      output.reserve(estimatedStringSize);
+    std::string toHexStringParallel(const unsigned char * iBuffer, size_t iSize, size_t iNumThreads)
+    {
+      std::string output;
+      if (!encodeParallel(output, iBuffer, iSize, &gCharacterTable.getHexEncodings(), &gCharacterTable.getHexNullBeforeDigit(), iNumThreads))
+        return toHexString(iBuffer, iSize);
+      return output;
+    }
 
-      enum CHARACTER_TYPE
+    std::string toCppCharactersArrayParallel(const unsigned char * iBuffer, size_t iSize, size_t iNumThreads)
+    {
+      std::string output;
+      if (!encodeParallel(output, iBuffer, iSize, NULL, NULL, iNumThreads))
+        return toCppCharactersArray(iBuffer, iSize);
+      output.resize(output.size() - 1); //remove the last separator
+      return output;
+    }
+
+    //Writes encoded characters to a file with line wrapping.
+    class FileWriter
+    {
+    public:
+      FileWriter(FILE * iFile, size_t iLineLength, const char * iLineBreak) :
+        mFile(iFile),
+        mBuffer(BUFFER_SIZE),
+        mSize(0),
+        mLineLength(0),
+        mMaxLineLength(iLineLength),
+        mLineBreak(iLineBreak),
+        mLineBreakLength(strlen(iLineBreak)),
+        mError(false)
       {
-        OCTAL,
-        CONTROL,
-        PRINTABLE,
-      };
+      }
 
-      CHARACTER_TYPE previous = PRINTABLE;
-      for(size_t i=0; i<iSize; i++)
+      inline void append(const ENCODING & iEncoding)
       {
-        unsigned char c = iBuffer[i];
-        unsigned char next = iBuffer[i+1];
-        if (i+1 == iSize) //if out of scope
-          next = '\0';
+        if (mMaxLineLength > 0 && mLineLength > 0 && mLineLength + iEncoding.length > mMaxLineLength)
+        {
+          write(mLineBreak, mLineBreakLength);
+          mLineLength = 0;
+        }
+        if (mSize + MAX_ENCODING_LENGTH > BUFFER_SIZE)
+          flush();
+        memcpy(&mBuffer[mSize], iEncoding.text, MAX_ENCODING_LENGTH);
+        mSize += iEncoding.length;
+        mLineLength += iEncoding.length;
+      }
+
+      void write(const char * iValue, size_t iLength)
+      {
+        if (mSize + iLength > BUFFER_SIZE)
+          flush();
+        if (iLength > BUFFER_SIZE)
+        {
+          mError |= (fwrite(iValue, 1, iLength, mFile) != iLength);
+          return;
+        }
+        memcpy(&mBuffer[mSize], iValue, iLength);
+        mSize += iLength;
+      }
+
+      void write(const std::string & iValue)
+      {
+        write(iValue.data(), iValue.size());
+      }
+
+      bool flush()
+      {
+        if (mSize > 0)
+          mError |= (fwrite(&mBuffer[0], 1, mSize, mFile) != mSize);
+        mSize = 0;
+        return !mError;
+      }
+
+    private:
+      static const size_t BUFFER_SIZE = 64*1024;
+
+      FILE * mFile;
+      std::vector<char> mBuffer;
+      size_t mSize;
+      size_t mLineLength;
+      size_t mMaxLineLength;
+      const char * mLineBreak;
+      size_t mLineBreakLength;
+      bool mError;
+    };
+
+    bool encodeFile(const char * iInputFilePath, const char * iOutputFilePath, const char * iVariableName, CPP_ENCODING iEncoding, size_t iLineLength)
+    {
+      if (iInputFilePath == NULL || iOutputFilePath == NULL || iVariableName == NULL)
+        return false;
+
+      FILE * input = fopen(iInputFilePath, "rb");
+      if (input == NULL)
+        return false;
+      FILE * output = fopen(iOutputFilePath, "wb");
+      if (output == NULL)
+      {
+        fclose(input);
+        return false;
+      }
+
+      const bool isArray = (iEncoding == ENCODING_CHARACTERS_ARRAY);
+      const STATE_ENCODINGS & encodings = (iEncoding == ENCODING_HEX_STRING ? gCharacterTable.getHexEncodings() : gCharacterTable.getOctEncodings(true));
+      const ENCODING & nullBeforeDigit = (iEncoding == ENCODING_HEX_STRING ? gCharacterTable.getHexNullBeforeDigit() : gCharacterTable.getOctNullBeforeDigit());
+
+      FileWriter writer(output, iLineLength, (isArray ? "\n" : "\"\n\""));
+      //variables are declared extern so that the generated file can be compiled as its own translation unit
+      writer.write(std::string("#include <stddef.h>\n\n"));
+      if (isArray)
+        writer.write(std::string("extern const unsigned char ") + iVariableName + "[] = {\n");
+      else
+        writer.write(std::string("extern const char ") + iVariableName + "[] =\n\"");
+
+      //The last character of each chunk is kept for the next chunk since
+      //the encoding of a NULL character depends on the following character.
+      static const size_t CHUNK_SIZE = 64*1024;
+      std::vector<unsigned char> buffer(CHUNK_SIZE + 1);
+      size_t pending = 0;
+      size_t state = STATE_DEFAULT;
+      uint64_t fileSize = 0;
+      while(true)
+      {
+        const size_t read = fread(&buffer[pending], 1, CHUNK_SIZE, input);
+        const size_t available = pending + read;
+        const bool last = (read < CHUNK_SIZE);
+        const size_t count = (last ? available : available - 1);
+
+        if (isArray)
+          encodeCharactersArray(&buffer[0], count, writer);
+        else
+          state = encodeStringLiteral(encodings, nullBeforeDigit, &buffer[0], count, available, state, writer);
+        fileSize += count;
+
+        if (last)
+          break;
+        buffer[0] = buffer[available - 1];
+        pending = 1;
+      }
+
+      if (isArray)
+      {
+        if (fileSize == 0)
+          writer.write("0", 1); //empty arrays are not allowed
+        writer.write(std::string("\n};\n"));
+      }
+      else
+        writer.write(std::string("\";\n"));
+      writer.write(std::string("extern const size_t ") + iVariableName + "_size = " + ra::strings::toString(fileSize) + ";\n");
+
+      bool success = !ferror(input);
+      success &= writer.flush();
+      fclose(input);
+      success &= (fclose(output) == 0);
+      return success;
+    }
+
+    //Appends encoded values to a string with line wrapping.
+    struct LINE_WRITER
+    {
+      std::string & output;
+      size_t lineLength;
+      size_t maxLineLength;
+      const char * lineBreak;
+
+      inline void append(const char * iValue, size_t iLength)
+      {
+        if (lineLength > 0 && lineLength + iLength > maxLineLength)
+        {
+          output.append(lineBreak);
+          lineLength = 0;
+        }
+        output.append(iValue, iLength);
+        lineLength += iLength;
+      }
+
+      inline void append(const ENCODING & iEncoding)
+      {
+        append(iEncoding.text, iEncoding.length);
+      }
+    };
+
+    //Blocks selection parameters of toCppSource()
+    static const size_t CPP_SOURCE_BLOCK_SIZE = 4096;
+    static const size_t CPP_SOURCE_MIN_RUN_LENGTH = 64;
+    static const size_t CPP_SOURCE_LINE_LENGTH = 100;
+
+    //Formats a 32 bits word as the shortest hexadecimal literal. Returns the length of the literal.
+    //Hexadecimal literals without suffix take the first type which can hold their value which keeps the code valid c++98.
+    inline size_t formatWord(uint32_t iWord, char * oText)
+    {
+      char digits[8];
+      size_t numDigits = 0;
+      do
+      {
+        digits[numDigits++] = gHexDigits[iWord & 0x0F];
+        iWord >>= 4;
+      } while (iWord != 0);
+
+      size_t length = 0;
+      oText[length++] = '0';
+      oText[length++] = 'x';
+      while(numDigits > 0)
+        oText[length++] = digits[--numDigits];
+      oText[length++] = ',';
+      return length;
+    }
+
+    //Returns the 32 bits little endian word at the given offset of a block. Missing bytes at the end of the block are zeros.
+    inline uint32_t getWord(const unsigned char * iBuffer, size_t iSize, size_t iOffset)
+    {
+      uint32_t word = 0;
+      for(size_t i=0; i<4 && iOffset + i < iSize; i++)
+        word |= ((uint32_t)iBuffer[iOffset + i]) << (8*i);
+      return word;
+    }
 
-        if (c == 0 && !isDigitCharacter(next))
+    //Returns the length of the run of identical values starting at iOffset.
+    inline size_t getRunLength(const unsigned char * iBuffer, size_t iSize, size_t iOffset)
+    {
+      size_t end = iOffset + 1;
+      while(end < iSize && iBuffer[end] == iBuffer[iOffset])
+        end++;
+      return end - iOffset;
+    }
+
+    //Partitions the buffer into run-length blocks and data blocks of at most CPP_SOURCE_BLOCK_SIZE bytes.
+    //The representation of data blocks is selected by toCppSource().
+    void partitionBlocks(const unsigned char * iBuffer, size_t iSize, BlockEncodingList & oBlocks)
+    {
+      oBlocks.clear();
+      size_t position = 0;
+      while(position < iSize)
+      {
+        const size_t end = (iSize - position > CPP_SOURCE_BLOCK_SIZE ? position + CPP_SOURCE_BLOCK_SIZE : iSize);
+
+        //look for a long run within the block
+        size_t runOffset = end;
+        size_t runLength = 0;
+        for(size_t i = position; i < end; )
         {
-          //safe to encode NULL character as '\0' instead of '\000'
-          output.append(getControlCharacterEscapeString(c));
-          previous = OCTAL;
+          const size_t length = getRunLength(iBuffer, iSize, i);
+          if (length >= CPP_SOURCE_MIN_RUN_LENGTH)
+          {
+            runOffset = i;
+            runLength = length;
+            break;
+          }
+          i += length;
         }
-        else if (c == 0)
+
+        if (runOffset > position)
         {
-          output.append(toOctString(c));
-          previous = OCTAL;
+          BLOCK_ENCODING block;
+          block.offset = position;
+          block.size = runOffset - position;
+          block.strategy = STRATEGY_STRING_LITERAL;
+          block.encodedSize = 0;
+          oBlocks.push_back(block);
         }
-        else if (isControlCharacter(c))
+        if (runLength > 0)
         {
-          output.append(getControlCharacterEscapeString(c));
-          previous = CONTROL;
+          BLOCK_ENCODING block;
+          block.offset = runOffset;
+          block.size = runLength;
+          block.strategy = STRATEGY_RUN_LENGTH;
+          block.encodedSize = 0;
+          oBlocks.push_back(block);
         }
-        else if (iDisableWarningC4125 && previous == OCTAL && isDigitCharacter(c) ) //prevent warning C4125: decimal digit terminates octal escape sequence
+        position = runOffset + runLength;
+      }
+    }
+
+    //Appends the declaration (if any) and the decoding statement of a block using the given strategy.
+    void appendBlock(const unsigned char * iBuffer, const BLOCK_ENCODING & iBlock, BLOCK_STRATEGY iStrategy, const std::string & iBlockName, std::string & ioDeclarations, std::string & ioDecode)
+    {
+      const unsigned char * buffer = iBuffer + iBlock.offset;
+      const std::string offset = ra::strings::toString((uint64_t)iBlock.offset);
+      const std::string size = ra::strings::toString((uint64_t)iBlock.size);
+
+      if (iStrategy == STRATEGY_STRING_LITERAL)
+      {
+        ioDeclarations.append("static const char " + iBlockName + "[] =\n\"");
+        LINE_WRITER writer = {ioDeclarations, 0, CPP_SOURCE_LINE_LENGTH, "\"\n\""};
+        encodeStringLiteral(gCharacterTable.getOctEncodings(true), gCharacterTable.getOctNullBeforeDigit(), buffer, iBlock.size, iBlock.size, STATE_DEFAULT, writer);
+        ioDeclarations.append("\";\n");
+        ioDecode.append("  memcpy(oBuffer + " + offset + ", " + iBlockName + ", " + size + ");\n");
+      }
+      else if (iStrategy == STRATEGY_UINT32_ARRAY)
+      {
+        ioDeclarations.append("static const unsigned int " + iBlockName + "[] = {\n");
+        LINE_WRITER writer = {ioDeclarations, 0, CPP_SOURCE_LINE_LENGTH, "\n"};
+        char text[16];
+        for(size_t j=0; j<iBlock.size; j += 4)
         {
-          //character must be encoded as octal instead of printable
-          output.append(toOctString(c));
-          previous = OCTAL;
+          const size_t length = formatWord(getWord(buffer, iBlock.size, j), text);
+          writer.append(text, length);
         }
-        else if (isPrintableCharacter(c))
+        ioDeclarations.append("\n};\n");
+        ioDecode.append("  for(size_t i=0; i<" + size + "; i++) oBuffer[" + offset + " + i] = (unsigned char)(" + iBlockName + "[i/4] >> (8*(i%4)));\n");
+      }
+      else
+      {
+        ioDecode.append("  memset(oBuffer + " + offset + ", " + ra::strings::toString((uint64_t)buffer[0]) + ", " + size + ");\n");
+      }
+    }
+
+    std::string toCppSource(const unsigned char * iBuffer, size_t iSize, const char * iVariableName, BlockEncodingList & oBlocks)
+    {
+      partitionBlocks(iBuffer, iSize, oBlocks);
+
+      const std::string name = iVariableName;
+      std::string output;
+      output.append("#include <stddef.h>\n");
+      output.append("#include <string.h>\n");
+      output.append("\n");
+
+      std::string decode;
+      std::string stringDeclaration;
+      std::string stringDecode;
+      std::string arrayDeclaration;
+      std::string arrayDecode;
+      for(size_t i=0; i<oBlocks.size(); i++)
+      {
+        BLOCK_ENCODING & block = oBlocks[i];
+        const std::string blockName = name + "_block" + ra::strings::toString((uint64_t)i);
+        const size_t start = output.size() + decode.size();
+
+        if (block.strategy == STRATEGY_RUN_LENGTH)
         {
-          output.append(1, c);
-          previous = PRINTABLE;
+          appendBlock(iBuffer, block, STRATEGY_RUN_LENGTH, blockName, output, decode);
         }
         else
         {
-          output.append(toOctString(c));
-          previous = OCTAL;
+          //generate both representations and keep the smallest, including line breaks, declaration and decoding statement.
+          //Ties are resolved in favor of string literals.
+          stringDeclaration.clear();
+          stringDecode.clear();
+          arrayDeclaration.clear();
+          arrayDecode.clear();
+          appendBlock(iBuffer, block, STRATEGY_STRING_LITERAL, blockName, stringDeclaration, stringDecode);
+          appendBlock(iBuffer, block, STRATEGY_UINT32_ARRAY, blockName, arrayDeclaration, arrayDecode);
+          if (arrayDeclaration.size() + arrayDecode.size() < stringDeclaration.size() + stringDecode.size())
+          {
+            block.strategy = STRATEGY_UINT32_ARRAY;
+            output.append(arrayDeclaration);
+            decode.append(arrayDecode);
+          }
+          else
+          {
+            block.strategy = STRATEGY_STRING_LITERAL;
+            output.append(stringDeclaration);
+            decode.append(stringDecode);
+          }
         }
+        block.encodedSize = output.size() + decode.size() - start;
       }
 
+      //the size and the decoding function have external linkage so that the generated code can be compiled as its own source file.
+      //Block variables are static to allow multiple generated files in the same program.
+      output.append("\n");
+      output.append("extern const size_t " + name + "_size = " + ra::strings::toString((uint64_t)iSize) + ";\n");
+      output.append("\n");
+      output.append("void " + name + "_decode(unsigned char * oBuffer)\n");
+      output.append("{\n");
+      output.append(decode);
+      output.append("}\n");
       return output;
     }
 
-    std::string toHexString(const unsigned char * iBuffer, size_t iSize)
+    //States of the string literal decoder
+    enum DECODE_STATE
     {
-      std::string output;
+      DECODE_TEXT,        //characters without escape sequence
+      DECODE_ESCAPE,      //after '\\'
+      DECODE_OCT1,        //after the first digit of an octal escape sequence
+      DECODE_OCT2,        //after the second digit of an octal escape sequence
+      DECODE_HEX_FIRST,   //after '\x'
+      DECODE_HEX,         //after one or more hexadecimal digits
+      NUM_DECODE_STATES
+    };
 
-      //estimate the size of the output string to prevent memory copy
-      //assume 50% of buffer is *NOT* printable
-      size_t nonPrintableSize = ((iSize*50)/100);
-      size_t estimatedStringSize = iSize - nonPrintableSize + nonPrintableSize*4; //4 bytes per hex characters
-      output.reserve(estimatedStringSize);
+    enum DECODE_ACTION
+    {
+      ACTION_COPY,        //write the character as is
+      ACTION_SKIP,        //consume the character
+      ACTION_ESCAPE,      //write the value of a simple escape sequence
+      ACTION_FIRST_DIGIT, //start the value of a numeric escape sequence
+      ACTION_NEXT_OCT,    //append an octal digit to the value
+      ACTION_LAST_OCT,    //append the last octal digit and write the value
+      ACTION_NEXT_HEX,    //append an hexadecimal digit to the value
+      ACTION_END_VALUE,   //write the value of the numeric escape sequence and decode the character again as text
+      ACTION_ERROR        //invalid string literal
+    };
 
-      enum CHARACTER_TYPE
-      {
-        HEX,
-        CONTROL,
-        PRINTABLE,
-      };
+    struct DECODE_TRANSITION
+    {
+      unsigned char action;
+      unsigned char nextState;
+    };
 
-      CHARACTER_TYPE previous = PRINTABLE;
-      for(size_t i=0; i<iSize; i++)
-      {
-        unsigned char c = iBuffer[i];
-        unsigned char next = iBuffer[i+1];
-        if (i+1 == iSize) //if out of scope
-          next = '\0';
+    #define RA_DECODE_ERROR {ACTION_ERROR, DECODE_TEXT}
+    #define RA_DECODE_END_VALUE {ACTION_END_VALUE, DECODE_TEXT}
+    static const DECODE_TRANSITION gDecodeTransitions[NUM_DECODE_STATES][NUM_DECODE_CLASSES] = {
+      //CLASS_CHARACTER           CLASS_BACKSLASH             CLASS_QUOTE                 CLASS_OCT_DIGIT                     CLASS_DEC_DIGIT                     CLASS_HEX_ESCAPE                    CLASS_HEX_LETTER                    CLASS_X                         CLASS_ESCAPE
+      { {ACTION_COPY, DECODE_TEXT}, {ACTION_SKIP, DECODE_ESCAPE}, RA_DECODE_ERROR,            {ACTION_COPY, DECODE_TEXT},         {ACTION_COPY, DECODE_TEXT},         {ACTION_COPY, DECODE_TEXT},         {ACTION_COPY, DECODE_TEXT},         {ACTION_COPY, DECODE_TEXT},     {ACTION_COPY, DECODE_TEXT}   }, //DECODE_TEXT
+      { RA_DECODE_ERROR,           {ACTION_ESCAPE, DECODE_TEXT}, {ACTION_ESCAPE, DECODE_TEXT}, {ACTION_FIRST_DIGIT, DECODE_OCT1}, RA_DECODE_ERROR,                    {ACTION_ESCAPE, DECODE_TEXT},       RA_DECODE_ERROR,                    {ACTION_SKIP, DECODE_HEX_FIRST}, {ACTION_ESCAPE, DECODE_TEXT} }, //DECODE_ESCAPE
+      { RA_DECODE_END_VALUE,       RA_DECODE_END_VALUE,          RA_DECODE_END_VALUE,          {ACTION_NEXT_OCT, DECODE_OCT2},     RA_DECODE_END_VALUE,                RA_DECODE_END_VALUE,                RA_DECODE_END_VALUE,                RA_DECODE_END_VALUE,            RA_DECODE_END_VALUE          }, //DECODE_OCT1
+      { RA_DECODE_END_VALUE,       RA_DECODE_END_VALUE,          RA_DECODE_END_VALUE,          {ACTION_LAST_OCT, DECODE_TEXT},     RA_DECODE_END_VALUE,                RA_DECODE_END_VALUE,                RA_DECODE_END_VALUE,                RA_DECODE_END_VALUE,            RA_DECODE_END_VALUE          }, //DECODE_OCT2
+      { RA_DECODE_ERROR,           RA_DECODE_ERROR,              RA_DECODE_ERROR,              {ACTION_FIRST_DIGIT, DECODE_HEX},   {ACTION_FIRST_DIGIT, DECODE_HEX},   {ACTION_FIRST_DIGIT, DECODE_HEX},   {ACTION_FIRST_DIGIT, DECODE_HEX},   RA_DECODE_ERROR,                RA_DECODE_ERROR              }, //DECODE_HEX_FIRST
+      { RA_DECODE_END_VALUE,       RA_DECODE_END_VALUE,          RA_DECODE_END_VALUE,          {ACTION_NEXT_HEX, DECODE_HEX},      {ACTION_NEXT_HEX, DECODE_HEX},      {ACTION_NEXT_HEX, DECODE_HEX},      {ACTION_NEXT_HEX, DECODE_HEX},      RA_DECODE_END_VALUE,            RA_DECODE_END_VALUE          }, //DECODE_HEX
+    };
+    #undef RA_DECODE_ERROR
+    #undef RA_DECODE_END_VALUE
 
-        if (c == 0 && !isDigitCharacter(next))
+    //Returns the position of the next '\\' or '"' character in [iFirst, iLast). Returns iLast if not found.
+    inline const char * findSpecialCharacter(const char * iFirst, const char * iLast)
+    {
+      const char * p = iFirst;
+#ifdef RA_CPPENCODER_SSE2
+      const __m128i backslash = _mm_set1_epi8('\\');
+      const __m128i quote = _mm_set1_epi8('"');
+      while(iLast - p >= 16)
+      {
+        const __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+        const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, backslash), _mm_cmpeq_epi8(chunk, quote)));
+        if (mask != 0)
         {
-          //safe to encode NULL character as '\0' instead of '\000'
-          output.append(getControlCharacterEscapeString(c));
-          previous = CONTROL;
+          for(int j=0; j<16; j++)
+          {
+            if ((mask & (1 << j)) != 0)
+              return p + j;
+          }
         }
-        else if (c == 0)
+        p += 16;
+      }
+#endif
+      while(p != iLast && *p != '\\' && *p != '"')
+        p++;
+      return p;
+    }
+
+    bool decodeStringLiteral(const char * iText, size_t iLength, unsigned char * oBuffer, size_t & oSize)
+    {
+      oSize = 0;
+      const char * p = iText;
+      const char * last = iText + iLength;
+      unsigned char * output = oBuffer;
+      size_t state = DECODE_TEXT;
+      unsigned int value = 0;
+      while(p != last)
+      {
+        if (state == DECODE_TEXT)
         {
-          output.append(toHexString(c));
-          previous = HEX;
+          //copy all characters up to the next escape sequence
+          const char * special = findSpecialCharacter(p, last);
+          memcpy(output, p, special - p);
+          output += special - p;
+          p = special;
+          if (p == last)
+            break;
         }
-        else if (isControlCharacter(c))
+
+        const CHARACTER_INFO & info = gCharacterTable[(unsigned char)*p];
+        const DECODE_TRANSITION & transition = gDecodeTransitions[state][info.decodeClass];
+        switch(transition.action)
         {
-          output.append(getControlCharacterEscapeString(c));
-          previous = CONTROL;
-        }
-        else if (previous == HEX && isHexCharacter(c)) //an hexadecimal letter cannot follow an hexadecimal escape sequence.
+        case ACTION_COPY:
+          *output++ = (unsigned char)*p;
+          break;
+        case ACTION_SKIP:
+          break;
+        case ACTION_ESCAPE:
+          *output++ = info.escapeValue;
+          break;
+        case ACTION_FIRST_DIGIT:
+          value = info.digitValue;
+          break;
+        case ACTION_NEXT_OCT:
+          value = value * 8 + info.digitValue;
+          break;
+        case ACTION_LAST_OCT:
+          value = value * 8 + info.digitValue;
+          if (value > 0xFF)
+            return false;
+          *output++ = (unsigned char)value;
+          break;
+        case ACTION_NEXT_HEX:
+          value = value * 16 + info.digitValue;
+          if (value > 0xFF)
+            return false;
+          break;
+        case ACTION_END_VALUE:
+          *output++ = (unsigned char)value;
+          state = DECODE_TEXT;
+          continue; //decode the character again
+        default:
+          return false;
+        };
+        state = transition.nextState;
+        p++;
+      }
+
+      //terminate a pending escape sequence
+      if (state == DECODE_ESCAPE || state == DECODE_HEX_FIRST)
+        return false;
+      if (state != DECODE_TEXT)
+        *output++ = (unsigned char)value;
+
+      oSize = output - oBuffer;
+      return true;
+    }
+
+    inline bool isWhiteSpace(char c)
+    {
+      return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+    }
+
+    bool decodeCharactersArray(const char * iText, size_t iLength, unsigned char * oBuffer, size_t & oSize)
+    {
+      oSize = 0;
+      const char * p = iText;
+      const char * last = iText + iLength;
+      unsigned char * output = oBuffer;
+      while(true)
+      {
+        while(p != last && isWhiteSpace(*p))
+          p++;
+        if (p == last)
+          break;
+
+        //read a value
+        if (*p == '\'')
         {
-          //must also be printed as an hexadecimal escape sequence
-          //http://stackoverflow.com/questions/5784969/when-did-c-compilers-start-considering-more-than-two-hex-digits-in-string-lite
-          output.append(toHexString(c));
-          previous = HEX;
+          //printable character
+          if (last - p < 3 || p[2] != '\'' || !(gCharacterTable[(unsigned char)p[1]].flags & FLAG_PRINTABLE))
+            return false;
+          *output++ = (unsigned char)p[1];
+          p += 3;
         }
-        else if (isPrintableCharacter(c))
+        else if (gCharacterTable[(unsigned char)*p].flags & FLAG_DIGIT)
         {
-          output.append(1, c);
-          previous = PRINTABLE;
+          //decimal value
+          unsigned int value = 0;
+          const char * first = p;
+          while(p != last && (gCharacterTable[(unsigned char)*p].flags & FLAG_DIGIT) && p - first < 3)
+          {
+            value = value * 10 + gCharacterTable[(unsigned char)*p].digitValue;
+            p++;
+          }
+          if (value > 0xFF || (p != last && (gCharacterTable[(unsigned char)*p].flags & FLAG_DIGIT)))
+            return false;
+          *output++ = (unsigned char)value;
         }
         else
         {
-          output.append(toHexString(c));
-          previous = HEX;
+          return false;
         }
+
+        //read the separator
+        while(p != last && isWhiteSpace(*p))
+          p++;
+        if (p == last)
+          break;
+        if (*p != ',')
+          return false;
+        p++;
       }
 
-      return output;
+      oSize = output - oBuffer;
+      return true;
     }
 
-    std::string toCppCharactersArray(const unsigned char * iBuffer, size_t iSize)
+    static const char * gBase64Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static const unsigned char INVALID_VALUE = 0xFF;
+
+    //value of each hexadecimal character. INVALID_VALUE for other characters.
+    static const unsigned char gHexValues[256] = {
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    };
+
+    //value of each base64 character. INVALID_VALUE for other characters.
+    static const unsigned char gBase64Values[256] = {
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+      0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+      0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+      0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    };
+
+#ifdef RA_CPPENCODER_SSE2
+    //Returns a mask of the 16 characters which are in the range [iFirst, iLast].
+    inline __m128i getRangeMaskSSE2(__m128i iChars, char iFirst, char iLast)
+    {
+      return _mm_and_si128(_mm_cmpgt_epi8(iChars, _mm_set1_epi8(iFirst - 1)), _mm_cmplt_epi8(iChars, _mm_set1_epi8(iLast + 1)));
+    }
+
+    //Converts 16 hexadecimal characters to their values. Returns false if a character is not an hexadecimal character.
+    inline bool getHexValuesSSE2(__m128i iChars, __m128i & oValues)
+    {
+      const __m128i lower = _mm_or_si128(iChars, _mm_set1_epi8(0x20));
+      const __m128i isDigit = getRangeMaskSSE2(iChars, '0', '9');
+      const __m128i isLetter = getRangeMaskSSE2(lower, 'a', 'f');
+      const __m128i digits = _mm_and_si128(isDigit, _mm_sub_epi8(iChars, _mm_set1_epi8('0')));
+      const __m128i letters = _mm_and_si128(isLetter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+      oValues = _mm_or_si128(digits, letters);
+      return _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) == 0xFFFF;
+    }
+
+    //Combines the pairs of nibbles of 16 hexadecimal values into 8 bytes, one per 16 bits lane.
+    inline __m128i combineNibblesSSE2(__m128i iValues)
+    {
+      const __m128i high = _mm_slli_epi16(_mm_and_si128(iValues, _mm_set1_epi16(0x00FF)), 4);
+      const __m128i low = _mm_srli_epi16(iValues, 8);
+      return _mm_or_si128(high, low);
+    }
+
+    //Converts 16 base64 characters to their values. Returns false if a character is not a base64 character.
+    inline bool getBase64ValuesSSE2(__m128i iChars, __m128i & oValues)
+    {
+      const __m128i isUpper = getRangeMaskSSE2(iChars, 'A', 'Z');
+      const __m128i isLower = getRangeMaskSSE2(iChars, 'a', 'z');
+      const __m128i isDigit = getRangeMaskSSE2(iChars, '0', '9');
+      const __m128i isPlus = _mm_cmpeq_epi8(iChars, _mm_set1_epi8('+'));
+      const __m128i isSlash = _mm_cmpeq_epi8(iChars, _mm_set1_epi8('/'));
+      __m128i values = _mm_and_si128(isUpper, _mm_sub_epi8(iChars, _mm_set1_epi8('A')));
+      values = _mm_or_si128(values, _mm_and_si128(isLower, _mm_sub_epi8(iChars, _mm_set1_epi8('a' - 26))));
+      values = _mm_or_si128(values, _mm_and_si128(isDigit, _mm_add_epi8(iChars, _mm_set1_epi8(52 - '0'))));
+      values = _mm_or_si128(values, _mm_and_si128(isPlus, _mm_set1_epi8(62)));
+      values = _mm_or_si128(values, _mm_and_si128(isSlash, _mm_set1_epi8(63)));
+      oValues = values;
+      const __m128i valid = _mm_or_si128(_mm_or_si128(isUpper, isLower), _mm_or_si128(isDigit, _mm_or_si128(isPlus, isSlash)));
+      return _mm_movemask_epi8(valid) == 0xFFFF;
+    }
+
+    //Converts 16 values in the range [0, 63] to base64 characters.
+    inline __m128i getBase64CharsSSE2(__m128i iValues)
+    {
+      //start from 'A' and add the offset of each following range of the alphabet
+      __m128i chars = _mm_add_epi8(iValues, _mm_set1_epi8('A'));
+      chars = _mm_add_epi8(chars, _mm_and_si128(_mm_cmpgt_epi8(iValues, _mm_set1_epi8(25)), _mm_set1_epi8(('a' - 26) - 'A')));
+      chars = _mm_add_epi8(chars, _mm_and_si128(_mm_cmpgt_epi8(iValues, _mm_set1_epi8(51)), _mm_set1_epi8(('0' - 52) - ('a' - 26))));
+      chars = _mm_add_epi8(chars, _mm_and_si128(_mm_cmpgt_epi8(iValues, _mm_set1_epi8(61)), _mm_set1_epi8(('+' - 62) - ('0' - 52))));
+      chars = _mm_add_epi8(chars, _mm_and_si128(_mm_cmpgt_epi8(iValues, _mm_set1_epi8(62)), _mm_set1_epi8(('/' - 63) - ('+' - 62))));
+      return chars;
+    }
+#endif //RA_CPPENCODER_SSE2
+
+    size_t getHexEncodedSize(size_t iSize)
     {
-      std::ostringstream oss;
+      return iSize * 2;
+    }
 
-      for(size_t i=0; i<iSize; i++)
+    size_t encodeHex(const unsigned char * iBuffer, size_t iSize, char * oText)
+    {
+      size_t i = 0;
+      char * output = oText;
+#ifdef RA_CPPENCODER_SSE2
+      const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+      for(; i + 16 <= iSize; i += 16)
+      {
+        const __m128i bytes = _mm_loadu_si128((const __m128i *)(iBuffer + i));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask);
+        __m128i low = _mm_and_si128(bytes, nibbleMask);
+        //convert nibbles to characters: '0' + n for digits, 'a' + n - 10 for letters
+        high = _mm_add_epi8(_mm_add_epi8(high, _mm_set1_epi8('0')), _mm_and_si128(_mm_cmpgt_epi8(high, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10)));
+        low = _mm_add_epi8(_mm_add_epi8(low, _mm_set1_epi8('0')), _mm_and_si128(_mm_cmpgt_epi8(low, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10)));
+        _mm_storeu_si128((__m128i *)output, _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i *)(output + 16), _mm_unpackhi_epi8(high, low));
+        output += 32;
+      }
+#endif
+      for(; i < iSize; i++)
       {
-        unsigned char c = iBuffer[i];
+        const unsigned char c = iBuffer[i];
+        *output++ = gHexDigits[c >> 4];
+        *output++ = gHexDigits[c & 0x0F];
+      }
+      return output - oText;
+    }
 
-        if (isPrintableCharacter((char)c))
-          oss << '\'' << (char)c << '\'';
-        else
-          oss << (int)c; //print as decimal value
+    size_t getHexDecodedSize(size_t iLength)
+    {
+      return iLength / 2;
+    }
+
+    bool decodeHex(const char * iText, size_t iLength, unsigned char * oBuffer)
+    {
+      if (iLength % 2 != 0)
+        return false;
 
-        size_t lastByteIndex = iSize-1;
+      size_t i = 0;
+      unsigned char * output = oBuffer;
+#ifdef RA_CPPENCODER_SSE2
+      for(; i + 32 <= iLength; i += 32)
+      {
+        __m128i first;
+        __m128i second;
+        if (!getHexValuesSSE2(_mm_loadu_si128((const __m128i *)(iText + i)), first) ||
+            !getHexValuesSSE2(_mm_loadu_si128((const __m128i *)(iText + i + 16)), second))
+          return false;
+        _mm_storeu_si128((__m128i *)output, _mm_packus_epi16(combineNibblesSSE2(first), combineNibblesSSE2(second)));
+        output += 16;
+      }
+#endif
+      for(; i < iLength; i += 2)
+      {
+        const unsigned char high = gHexValues[(unsigned char)iText[i]];
+        const unsigned char low = gHexValues[(unsigned char)iText[i+1]];
+        if (high == INVALID_VALUE || low == INVALID_VALUE)
+          return false;
+        *output++ = (unsigned char)((high << 4) | low);
+      }
+      return true;
+    }
+
+    size_t getBase64EncodedSize(size_t iSize)
+    {
+      return ((iSize + 2) / 3) * 4;
+    }
+
+    size_t encodeBase64(const unsigned char * iBuffer, size_t iSize, char * oText)
+    {
+      size_t i = 0;
+      char * output = oText;
+#ifdef RA_CPPENCODER_SSE2
+      //12 bytes are encoded to 16 characters
+      for(; i + 12 <= iSize; i += 12)
+      {
+        const unsigned char * p = iBuffer + i;
+        const __m128i words = _mm_set_epi32(
+          (p[ 9] << 16) | (p[10] << 8) | p[11],
+          (p[ 6] << 16) | (p[ 7] << 8) | p[ 8],
+          (p[ 3] << 16) | (p[ 4] << 8) | p[ 5],
+          (p[ 0] << 16) | (p[ 1] << 8) | p[ 2]);
+        //move each 6 bits value of the 24 bits words to its own byte
+        __m128i values = _mm_and_si128(_mm_srli_epi32(words, 18), _mm_set1_epi32(0x0000003F));
+        values = _mm_or_si128(values, _mm_and_si128(_mm_srli_epi32(words, 4), _mm_set1_epi32(0x00003F00)));
+        values = _mm_or_si128(values, _mm_and_si128(_mm_slli_epi32(words, 10), _mm_set1_epi32(0x003F0000)));
+        values = _mm_or_si128(values, _mm_and_si128(_mm_slli_epi32(words, 24), _mm_set1_epi32(0x3F000000)));
+        _mm_storeu_si128((__m128i *)output, getBase64CharsSSE2(values));
+        output += 16;
+      }
+#endif
+      for(; i + 3 <= iSize; i += 3)
+      {
+        const uint32_t word = (iBuffer[i] << 16) | (iBuffer[i+1] << 8) | iBuffer[i+2];
+        *output++ = gBase64Alphabet[(word >> 18) & 0x3F];
+        *output++ = gBase64Alphabet[(word >> 12) & 0x3F];
+        *output++ = gBase64Alphabet[(word >>  6) & 0x3F];
+        *output++ = gBase64Alphabet[ word        & 0x3F];
+      }
+      const size_t remaining = iSize - i;
+      if (remaining > 0)
+      {
+        const uint32_t word = (iBuffer[i] << 16) | (remaining == 2 ? (iBuffer[i+1] << 8) : 0);
+        *output++ = gBase64Alphabet[(word >> 18) & 0x3F];
+        *output++ = gBase64Alphabet[(word >> 12) & 0x3F];
+        *output++ = (remaining == 2 ? gBase64Alphabet[(word >> 6) & 0x3F] : '=');
+        *output++ = '=';
+      }
+      return output - oText;
+    }
 
-        if (i != lastByteIndex)
-          oss << ",";
+    //Returns the number of base64 characters without the padding characters.
+    inline size_t getBase64UnpaddedLength(const char * iText, size_t iLength)
+    {
+      size_t length = iLength;
+      if (length % 4 == 0)
+      {
+        for(size_t i=0; i<2 && length > 0 && iText[length-1] == '='; i++)
+          length--;
       }
+      return length;
+    }
+
+    size_t getBase64DecodedSize(const char * iText, size_t iLength)
+    {
+      const size_t length = getBase64UnpaddedLength(iText, iLength);
+      const size_t remaining = length % 4;
+      return (length / 4) * 3 + (remaining > 1 ? remaining - 1 : 0);
+    }
 
-      return oss.str();
+    bool decodeBase64(const char * iText, size_t iLength, unsigned char * oBuffer)
+    {
+      const size_t length = getBase64UnpaddedLength(iText, iLength);
+      if (length % 4 == 1)
+        return false;
+
+      size_t i = 0;
+      unsigned char * output = oBuffer;
+#ifdef RA_CPPENCODER_SSE2
+      //16 characters are decoded to 12 bytes
+      for(; i + 16 <= length; i += 16)
+      {
+        __m128i values;
+        if (!getBase64ValuesSSE2(_mm_loadu_si128((const __m128i *)(iText + i)), values))
+          return false;
+        //combine the 4 values of each 32 bits lane into a 24 bits word
+        __m128i words = _mm_slli_epi32(_mm_and_si128(values, _mm_set1_epi32(0x0000003F)), 18);
+        words = _mm_or_si128(words, _mm_slli_epi32(_mm_and_si128(values, _mm_set1_epi32(0x00003F00)), 4));
+        words = _mm_or_si128(words, _mm_srli_epi32(_mm_and_si128(values, _mm_set1_epi32(0x003F0000)), 10));
+        words = _mm_or_si128(words, _mm_srli_epi32(values, 24));
+        uint32_t buffer[4];
+        _mm_storeu_si128((__m128i *)buffer, words);
+        for(size_t j=0; j<4; j++)
+        {
+          *output++ = (unsigned char)(buffer[j] >> 16);
+          *output++ = (unsigned char)(buffer[j] >> 8);
+          *output++ = (unsigned char)(buffer[j]);
+        }
+      }
+#endif
+      for(; i < length; i += 4)
+      {
+        const size_t count = (length - i < 4 ? length - i : 4);
+        uint32_t word = 0;
+        unsigned char invalid = 0;
+        for(size_t j=0; j<4; j++)
+        {
+          const unsigned char value = (j < count ? gBase64Values[(unsigned char)iText[i+j]] : 0);
+          invalid |= value;
+          word = (word << 6) | (value & 0x3F);
+        }
+        if (invalid & 0xC0)
+          return false;
+        *output++ = (unsigned char)(word >> 16);
+        if (count > 2)
+          *output++ = (unsigned char)(word >> 8);
+        if (count > 3)
+          *output++ = (unsigned char)(word);
+      }
+      return true;
     }
 
   }; //cppencoder
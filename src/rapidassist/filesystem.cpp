@@ -22,6 +22,10 @@
  * SOFTWARE.
  *********************************************************************************/
 
+#if !defined(_WIN32) && !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64 //for 64 bits st_size on 32 bits systems
+#endif
+
 #include "rapidassist/environment.h"
 #include "rapidassist/filesystem.h"
 #include "rapidassist/random.h"
@@ -33,7 +37,6 @@
 #include <sys/stat.h>
 
 #ifdef _WIN32
-#define stat _stat
 #define __getcwd _getcwd
 #define __chdir _chdir
 #define __rmdir _rmdir
@@ -58,6 +61,73 @@ namespace ra
       bool operator()(T const &a, T const &b) const { return a > b; }
     };
 
+    //stat() and fstat() with 64 bits file size
+#ifdef _WIN32
+    typedef struct __stat64 STAT_BUFFER;
+    inline int statPath(const char * iPath, STAT_BUFFER * oBuffer) { return _stat64(iPath, oBuffer); }
+    inline int statDescriptor(int iFileDescriptor, STAT_BUFFER * oBuffer) { return _fstat64(iFileDescriptor, oBuffer); }
+    inline int getFileDescriptor(FILE * f) { return _fileno(f); }
+#else
+    typedef struct stat STAT_BUFFER;
+    inline int statPath(const char * iPath, STAT_BUFFER * oBuffer) { return stat(iPath, oBuffer); }
+    inline int statDescriptor(int iFileDescriptor, STAT_BUFFER * oBuffer) { return fstat(iFileDescriptor, oBuffer); }
+    inline int getFileDescriptor(FILE * f) { return fileno(f); }
+#endif
+
+    inline void fillFileInfo(const STAT_BUFFER & iBuffer, FILE_INFO & oInfo)
+    {
+      const int type = (iBuffer.st_mode & S_IFMT);
+      if (type == S_IFREG)
+        oInfo.type = ENTRY_FILE;
+      else if (type == S_IFDIR)
+        oInfo.type = ENTRY_FOLDER;
+      else
+        oInfo.type = ENTRY_OTHER;
+      oInfo.size = (uint64_t)iBuffer.st_size;
+      oInfo.modifiedTime = (uint64_t)iBuffer.st_mtime;
+#ifdef __linux__
+      oInfo.modifiedTimeNanoseconds = (uint32_t)iBuffer.st_mtim.tv_nsec;
+#else
+      oInfo.modifiedTimeNanoseconds = 0;
+#endif
+      oInfo.mode = (uint32_t)iBuffer.st_mode;
+#ifdef _WIN32
+      oInfo.inode = 0; //st_ino has no meaning on Windows
+#else
+      oInfo.inode = (uint64_t)iBuffer.st_ino;
+#endif
+    }
+
+    bool getFileInfo(const char * iPath, FILE_INFO & oInfo)
+    {
+      STAT_BUFFER sb;
+      if (iPath != NULL && iPath[0] != '\0' && statPath(iPath, &sb) == 0)
+      {
+        fillFileInfo(sb, oInfo);
+        return true;
+      }
+
+      oInfo.type = ENTRY_NOT_FOUND;
+      oInfo.size = 0;
+      oInfo.modifiedTime = 0;
+      oInfo.modifiedTimeNanoseconds = 0;
+      oInfo.mode = 0;
+      oInfo.inode = 0;
+      return false;
+    }
+
+    size_t getFileInfo(const ra::strings::StringVector & iPaths, FileInfoList & oInfos)
+    {
+      oInfos.resize(iPaths.size());
+      size_t numFound = 0;
+      for(size_t i=0; i<iPaths.size(); i++)
+      {
+        if (getFileInfo(iPaths[i].c_str(), oInfos[i]))
+          numFound++;
+      }
+      return numFound;
+    }
+
     void normalizePath(std::string & path)
     {
       char separator = getPathSeparator();
@@ -83,27 +153,45 @@ namespace ra
 
     uint32_t getFileSize(const char * iPath)
     {
-      if (iPath == NULL || iPath[0] == '\0')
-        return 0;
-
-      struct stat sb;
-      if(stat(iPath, &sb)==0)
-      {
-        return sb.st_size;
-      }
-
-      return 0;
+      return (uint32_t)getFileSize64(iPath);
     }
 
     uint32_t getFileSize(FILE * f)
     {
+      //seek to the end of the stream which also includes data not flushed yet
       if (f == NULL)
         return 0;
       long initPos = ftell(f);
       fseek(f, 0, SEEK_END);
       long size = ftell(f);
       fseek(f, initPos, SEEK_SET);
-      return size;
+      return (uint32_t)size;
+    }
+
+    uint64_t getFileSize64(const char * iPath)
+    {
+      FILE_INFO info;
+      getFileInfo(iPath, info);
+      return info.size;
+    }
+
+    uint64_t getFileSize64(FILE * f)
+    {
+      if (f == NULL)
+        return 0;
+      return getFileDescriptorSize64(getFileDescriptor(f));
+    }
+
+    uint64_t getFileDescriptorSize64(int iFileDescriptor)
+    {
+      if (iFileDescriptor < 0)
+        return 0;
+
+      STAT_BUFFER sb;
+      if (statDescriptor(iFileDescriptor, &sb) == 0)
+        return (uint64_t)sb.st_size;
+
+      return 0;
     }
 
     std::string getFilename(const char * iPath)
@@ -120,44 +208,23 @@ namespace ra
 
     bool fileExists(const char * iPath)
     {
-      if (iPath == NULL || iPath[0] == '\0')
-        return false;
-
-      struct stat sb;
-      if(stat(iPath, &sb) == 0)
-      {
-        if ((sb.st_mode & S_IFREG) == S_IFREG)
-          return true;
-      }
-      return false;
+      FILE_INFO info;
+      getFileInfo(iPath, info);
+      return info.type == ENTRY_FILE;
     }
 
     bool hasReadAccess(const char * iPath)
     {
-      if (iPath == NULL || iPath[0] == '\0')
-        return false;
-
-      struct stat sb;
-      if(stat(iPath, &sb)==0)
-      {
-        if ((sb.st_mode & S_IREAD) == S_IREAD)
-          return true;
-      }
-      return false;
+      FILE_INFO info;
+      getFileInfo(iPath, info);
+      return (info.mode & S_IREAD) == S_IREAD;
     }
 
     bool hasWriteAccess(const char * iPath)
     {
-      if (iPath == NULL || iPath[0] == '\0')
-        return false;
-
-      struct stat sb;
-      if(stat(iPath, &sb)==0)
-      {
-        if ((sb.st_mode & S_IWRITE) == S_IWRITE)
-          return true;
-      }
-      return false;
+      FILE_INFO info;
+      getFileInfo(iPath, info);
+      return (info.mode & S_IWRITE) == S_IWRITE;
     }
 
     inline bool isCurrentFolder(const std::string & iPath)
@@ -170,8 +237,30 @@ namespace ra
       return iPath == "..";
     }
 
+    //list of directory entries with a flag telling if the entry is a folder.
+    typedef std::vector<std::pair<std::string, bool> > DirectoryEntryList;
+
+    inline void addDirectoryEntry(ra::strings::StringVector & oFiles, const std::string & iPath, bool /*isFolder*/)
+    {
+      oFiles.push_back(iPath);
+    }
+
+    inline void addDirectoryEntry(ra::strings::StringList & oFiles, const std::string & iPath, bool /*isFolder*/)
+    {
+      oFiles.push_back(iPath);
+    }
+
+    inline void addDirectoryEntry(DirectoryEntryList & oEntries, const std::string & iPath, bool isFolder)
+    {
+      oEntries.push_back(std::pair<std::string, bool>(iPath, isFolder));
+    }
+
+    template <class CONTAINER>
+    bool findFilesT(CONTAINER & oFiles, const char * iPath, int iDepth);
+
     //shared cross-platform code for findFiles().
-    bool processDirectoryEntry(ra::strings::StringVector & oFiles, const char * iFolderPath, const std::string & iFilename, bool isFolder, int iDepth)
+    template <class CONTAINER>
+    bool processDirectoryEntry(CONTAINER & oFiles, const char * iFolderPath, const std::string & iFilename, bool isFolder, int iDepth)
     {
       //is it a valid item ?
       if (!isCurrentFolder(iFilename) && !isParentFolder(iFilename))
@@ -180,7 +269,7 @@ namespace ra
         std::string fullFilename = iFolderPath;
         normalizePath(fullFilename);
         fullFilename << getPathSeparatorStr() << iFilename;
-        oFiles.push_back(fullFilename);
+        addDirectoryEntry(oFiles, fullFilename, isFolder);
  
         //should we recurse on folder ?
         if (isFolder && iDepth != 0)
@@ -191,7 +280,7 @@ namespace ra
             subDepth = -1;
 
           //find children
-          bool result = findFiles(oFiles, fullFilename.c_str(), subDepth);
+          bool result = findFilesT(oFiles, fullFilename.c_str(), subDepth);
           if (!result)
           {
             return false;
@@ -203,7 +292,8 @@ namespace ra
     }
 
 
-    bool findFiles(ra::strings::StringVector & oFiles, const char * iPath, int iDepth)
+    template <class CONTAINER>
+    bool findFilesT(CONTAINER & oFiles, const char * iPath, int iDepth)
     {
       if (iPath == NULL)
         return false;
@@ -266,6 +356,15 @@ namespace ra
       std::string filename = dirp->d_name;
  
       bool isFolder = (dirp->d_type == DT_DIR);
+      if (dirp->d_type == DT_UNKNOWN)
+      {
+        //some file systems do not report the type of entries
+        std::string fullFilename = iPath;
+        normalizePath(fullFilename);
+        fullFilename << getPathSeparatorStr() << filename;
+        struct stat buffer;
+        isFolder = (lstat(fullFilename.c_str(), &buffer) == 0 && S_ISDIR(buffer.st_mode));
+      }
       bool result = processDirectoryEntry(oFiles, iPath, filename, isFolder, iDepth);
       if (!result)
       {
@@ -277,23 +376,26 @@ namespace ra
 #endif
     }
 
-    bool folderExists(const char * iPath)
+    bool findFiles(ra::strings::StringVector & oFiles, const char * iPath, int iDepth)
     {
-      if (iPath == NULL || iPath[0] == '\0')
-        return false;
+      return findFilesT(oFiles, iPath, iDepth);
+    }
+
+    bool findFiles(ra::strings::StringList & oFiles, const char * iPath, int iDepth)
+    {
+      return findFilesT(oFiles, iPath, iDepth);
+    }
 
+    bool folderExists(const char * iPath)
+    {
 #ifdef _WIN32
-      //Note that the current windows implementation of folderExists() uses the _stat() API and the implementation has issues with junctions and symbolink link.
+      //Note that the current windows implementation of folderExists() uses the _stat64() API and the implementation has issues with junctions and symbolink link.
       //For instance, 'C:\Users\All Users\Favorites' exists but 'C:\Users\All Users' don't.
 #endif
 
-      struct stat sb;
-      if(stat(iPath, &sb)==0)
-      {
-        if ((sb.st_mode & S_IFDIR) == S_IFDIR)
-          return true;
-      }
-      return false;
+      FILE_INFO info;
+      getFileInfo(iPath, info);
+      return info.type == ENTRY_FOLDER;
     }
 
     bool createFolder(const char * iPath)
@@ -366,32 +468,34 @@ namespace ra
       //folder exists and must be deleted
 
       //find all files and folders in specified directory
-      ra::strings::StringVector files;
-      bool foundFiles = findFiles(files, iPath);
+      //the type of each entry is reported by the directory listing
+      DirectoryEntryList entries;
+      bool foundFiles = findFilesT(entries, iPath, -1);
       if (!foundFiles)
         return false;
 
       //soft files in reverse order
       //this allows deleting sub-folders and sub-files first
-      std::sort(files.begin(), files.end(), greater());
+      std::sort(entries.begin(), entries.end(), greater());
 
       //process files and folders
-      for(size_t i=0; i<files.size(); i++)
+      for(size_t i=0; i<entries.size(); i++)
       {
-        const std::string & direntry = files[i];
-        if (fileExists(direntry.c_str()))
+        const std::string & direntry = entries[i].first;
+        bool isFolder = entries[i].second;
+        if (isFolder)
         {
-          bool deleted = deleteFile(direntry.c_str());
-          if (!deleted)
-            return false; //failed to delete file
-        }
-        else
-        {
-          //assume direntry is a folder
           int result = __rmdir(direntry.c_str());
           if (result != 0)
             return false; //failed deleting folder.
         }
+        else
+        {
+          //files, symbolic links, sockets, pipes, devices...
+          bool deleted = deleteFile(direntry.c_str());
+          if (!deleted)
+            return false; //failed to delete file
+        }
       }
 
       //delete the specified folder
@@ -732,13 +836,9 @@ namespace ra
 
     uint64_t getFileModifiedDate(const std::string & iPath)
     {
-      struct stat result;
-      uint64_t mod_time = 0;
-      if(stat(iPath.c_str(), &result)==0)
-      {
-        mod_time = result.st_mtime;
-      }
-      return mod_time;
+      FILE_INFO info;
+      getFileInfo(iPath.c_str(), info);
+      return info.modifiedTime;
     }
 
   } //namespace filesystem
@@ -27,6 +27,7 @@
 #include <sstream> //for stringstream
 #include <iostream> //for std::hex
 #include <cstdio> //for remove()
+#include <climits> //for LONG_MAX
 
 #include <gtest/gtest.h>
 
@@ -198,11 +199,14 @@ namespace ra
       }
     }
 
-    StringVector getTestList(const char * iTestCasePath)
+    template <class CONTAINER>
+    bool getTestListT(const char * iTestCasePath, CONTAINER & oTests)
     {
+      oTests.clear();
+
       //check that file exists
       if (!fileExists(iTestCasePath))
-        return StringVector();
+        return false;
 
       static const std::string logFilename = "gTestHelper.tmp";
 
@@ -221,20 +225,19 @@ namespace ra
       //exec
       int returnCode = system(commandLine.c_str());
       if (returnCode != 0)
-        return StringVector();
+        return false;
 
       if (!fileExists(logFilename.c_str()))
-        return StringVector();
+        return false;
 
       //load test case list from log filename
-      StringVector testlist;
       static const std::string disabledTestCaseHeader = "  DISABLED_";
       static const std::string disabledTestSuiteHeader = "DISABLED_";
       std::string testSuiteName;
       std::string testCaseName;
       FILE * f = fopen(logFilename.c_str(), "r");
       if (!f)
-        return StringVector();
+        return false;
 
       static const int BUFFER_SIZE = 1024;
       char buffer[BUFFER_SIZE];
@@ -252,7 +255,7 @@ namespace ra
           std::string fullTestCaseName;
           fullTestCaseName.append(testSuiteName);
           fullTestCaseName.append(subString2(line, 2, 999));
-          testlist.push_back(fullTestCaseName);
+          oTests.push_back(fullTestCaseName);
         }
         else
         {
@@ -277,7 +280,19 @@ namespace ra
       //exec
       returnCode = system(commandLine.c_str());
 
-      return testlist;
+      return true;
+    }
+
+    StringVector getTestList(const char * iTestCasePath)
+    {
+      StringVector tests;
+      getTestListT(iTestCasePath, tests);
+      return tests;
+    }
+
+    bool getTestList(const char * iTestCasePath, StringList & oTests)
+    {
+      return getTestListT(iTestCasePath, oTests);
     }
 
     bool isFileEquals(const char* iFile1, const char* iFile2)
@@ -314,8 +329,8 @@ namespace ra
       }
 
       //Compare by size
-      long size1 = getFileSize(f1.mPointer);
-      long size2 = getFileSize(f2.mPointer);
+      uint64_t size1 = getFileSize64(f1.mPointer);
+      uint64_t size2 = getFileSize64(f2.mPointer);
       if (size1 != size2)
       {
         if (size1 < size2)
@@ -377,8 +392,8 @@ namespace ra
         return false;
 
       //Check by size
-      long size1 = getFileSize(f1.mPointer);
-      long size2 = getFileSize(f2.mPointer);
+      uint64_t size1 = getFileSize64(f1.mPointer);
+      uint64_t size2 = getFileSize64(f2.mPointer);
       if (size1 != size2)
       {
         return false; //unsupported
@@ -457,7 +472,8 @@ namespace ra
       return false;
     }
 
-    bool getTextFileContent(const char* iFilename, StringVector & oLines )
+    template <class CONTAINER>
+    bool getTextFileContentT(const char* iFilename, CONTAINER & oLines )
     {
       oLines.clear();
 
@@ -472,8 +488,7 @@ namespace ra
           //remove last CRLF at the end of the string
           removeEOL(buffer);
 
-          std::string line = buffer;
-          oLines.push_back(line);
+          oLines.push_back(buffer);
         }
         fclose(f);
         return true;
@@ -481,6 +496,16 @@ namespace ra
       return false;
     }
 
+    bool getTextFileContent(const char* iFilename, StringVector & oLines )
+    {
+      return getTextFileContentT(iFilename, oLines);
+    }
+
+    bool getTextFileContent(const char* iFilename, StringList & oLines )
+    {
+      return getTextFileContentT(iFilename, oLines);
+    }
+
     bool createFile(const char * iFilePath, size_t iSize)
     {
       FILE * f = fopen(iFilePath, "wb");
@@ -510,26 +535,13 @@ namespace ra
 
     void changeFileContent(const char * iFilePath, size_t iOffset, unsigned char iValue)
     {
-      //read
-      FILE * f = fopen(iFilePath, "rb");
-      if (!f)
-        return;
-      long size = getFileSize(f);
-      unsigned char * buffer = new unsigned char[size];
-      if (!buffer)
-        return;
-      size_t byteRead = fread(buffer, 1, size, f);
-      fclose(f);
-
-      //modify
-      if (iOffset < (size_t)size)
-        buffer[iOffset] = iValue;
-
-      //save
-      f = fopen(iFilePath, "wb");
+      //modify the byte in place instead of rewriting the whole file
+      FILE * f = fopen(iFilePath, "r+b");
       if (!f)
         return;
-      size_t byteWrite = fwrite(buffer, 1, size, f);
+      uint64_t size = getFileSize64(f);
+      if ((uint64_t)iOffset < size && iOffset <= (size_t)LONG_MAX && fseek(f, (long)iOffset, SEEK_SET) == 0)
+        fputc(iValue, f);
       fclose(f);
     }
 
@@ -0,0 +1,393 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "rapidassist/hash.h"
+
+#include <string.h> //for memcpy()
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define RA_HASH_X64
+#endif
+
+#if defined(RA_HASH_X64) || defined(__i386__) || defined(_M_IX86)
+#  if defined(_MSC_VER)
+#    define RA_HASH_CRC32C_X86
+#    include <intrin.h>    //for __cpuid()
+#    include <nmmintrin.h> //for _mm_crc32_u8()
+#  elif defined(__GNUC__)
+#    define RA_HASH_CRC32C_X86
+#  endif
+#endif
+
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define RA_HASH_LITTLE_ENDIAN
+#endif
+
+namespace ra
+{
+  namespace hash
+  {
+    static const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ull;
+    static const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+    static const uint64_t PRIME64_3 = 0x165667B19E3779F9ull;
+    static const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+    static const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+    inline uint64_t rotateLeft(uint64_t iValue, int iBits)
+    {
+      return (iValue << iBits) | (iValue >> (64 - iBits));
+    }
+
+    //Reads little endian values from unaligned memory.
+    inline uint64_t read64(const unsigned char * iBuffer)
+    {
+#ifdef RA_HASH_LITTLE_ENDIAN
+      uint64_t value;
+      memcpy(&value, iBuffer, sizeof(value));
+      return value;
+#else
+      uint64_t value = 0;
+      for(int i=7; i>=0; i--)
+        value = (value << 8) | iBuffer[i];
+      return value;
+#endif
+    }
+
+    inline uint32_t read32(const unsigned char * iBuffer)
+    {
+#ifdef RA_HASH_LITTLE_ENDIAN
+      uint32_t value;
+      memcpy(&value, iBuffer, sizeof(value));
+      return value;
+#else
+      return (uint32_t)iBuffer[0] | ((uint32_t)iBuffer[1] << 8) | ((uint32_t)iBuffer[2] << 16) | ((uint32_t)iBuffer[3] << 24);
+#endif
+    }
+
+    inline uint64_t xxh64Round(uint64_t iAccumulator, uint64_t iInput)
+    {
+      iAccumulator += iInput * PRIME64_2;
+      iAccumulator = rotateLeft(iAccumulator, 31);
+      return iAccumulator * PRIME64_1;
+    }
+
+    inline uint64_t xxh64MergeRound(uint64_t iHash, uint64_t iAccumulator)
+    {
+      iHash ^= xxh64Round(0, iAccumulator);
+      return iHash * PRIME64_1 + PRIME64_4;
+    }
+
+    inline void xxh64Init(uint64_t * oAccumulators, uint64_t iSeed)
+    {
+      oAccumulators[0] = iSeed + PRIME64_1 + PRIME64_2;
+      oAccumulators[1] = iSeed + PRIME64_2;
+      oAccumulators[2] = iSeed;
+      oAccumulators[3] = iSeed - PRIME64_1;
+    }
+
+    //Processes all full 32 bytes stripes of the buffer. Returns the number of bytes processed.
+    inline size_t xxh64Stripes(uint64_t * ioAccumulators, const unsigned char * iBuffer, size_t iSize)
+    {
+      const unsigned char * p = iBuffer;
+      const unsigned char * last = iBuffer + (iSize & ~(size_t)31);
+      uint64_t v1 = ioAccumulators[0];
+      uint64_t v2 = ioAccumulators[1];
+      uint64_t v3 = ioAccumulators[2];
+      uint64_t v4 = ioAccumulators[3];
+      while(p != last)
+      {
+        v1 = xxh64Round(v1, read64(p));
+        v2 = xxh64Round(v2, read64(p + 8));
+        v3 = xxh64Round(v3, read64(p + 16));
+        v4 = xxh64Round(v4, read64(p + 24));
+        p += 32;
+      }
+      ioAccumulators[0] = v1;
+      ioAccumulators[1] = v2;
+      ioAccumulators[2] = v3;
+      ioAccumulators[3] = v4;
+      return p - iBuffer;
+    }
+
+    inline uint64_t xxh64Converge(const uint64_t * iAccumulators)
+    {
+      uint64_t hash = rotateLeft(iAccumulators[0], 1) + rotateLeft(iAccumulators[1], 7) + rotateLeft(iAccumulators[2], 12) + rotateLeft(iAccumulators[3], 18);
+      hash = xxh64MergeRound(hash, iAccumulators[0]);
+      hash = xxh64MergeRound(hash, iAccumulators[1]);
+      hash = xxh64MergeRound(hash, iAccumulators[2]);
+      hash = xxh64MergeRound(hash, iAccumulators[3]);
+      return hash;
+    }
+
+    //Processes the remaining bytes (less than 32) and mixes the final hash.
+    inline uint64_t xxh64Finalize(uint64_t iHash, const unsigned char * iBuffer, size_t iSize)
+    {
+      while(iSize >= 8)
+      {
+        iHash ^= xxh64Round(0, read64(iBuffer));
+        iHash = rotateLeft(iHash, 27) * PRIME64_1 + PRIME64_4;
+        iBuffer += 8;
+        iSize -= 8;
+      }
+      if (iSize >= 4)
+      {
+        iHash ^= (uint64_t)read32(iBuffer) * PRIME64_1;
+        iHash = rotateLeft(iHash, 23) * PRIME64_2 + PRIME64_3;
+        iBuffer += 4;
+        iSize -= 4;
+      }
+      while(iSize > 0)
+      {
+        iHash ^= (*iBuffer) * PRIME64_5;
+        iHash = rotateLeft(iHash, 11) * PRIME64_1;
+        iBuffer++;
+        iSize--;
+      }
+
+      //avalanche
+      iHash ^= iHash >> 33;
+      iHash *= PRIME64_2;
+      iHash ^= iHash >> 29;
+      iHash *= PRIME64_3;
+      iHash ^= iHash >> 32;
+      return iHash;
+    }
+
+    uint64_t hash64(const void * iBuffer, size_t iSize, uint64_t iSeed)
+    {
+      const unsigned char * buffer = (const unsigned char *)iBuffer;
+      uint64_t hash;
+      size_t offset = 0;
+      if (iSize >= 32)
+      {
+        uint64_t accumulators[4];
+        xxh64Init(accumulators, iSeed);
+        offset = xxh64Stripes(accumulators, buffer, iSize);
+        hash = xxh64Converge(accumulators);
+      }
+      else
+      {
+        hash = iSeed + PRIME64_5;
+      }
+      hash += (uint64_t)iSize;
+      return xxh64Finalize(hash, buffer + offset, iSize - offset);
+    }
+
+    uint64_t hash64(const std::string & iValue)
+    {
+      return hash64(iValue.data(), iValue.size());
+    }
+
+    Hasher64::Hasher64(uint64_t iSeed)
+    {
+      reset(iSeed);
+    }
+
+    void Hasher64::reset(uint64_t iSeed)
+    {
+      mSeed = iSeed;
+      xxh64Init(mAccumulators, iSeed);
+      mTotalSize = 0;
+      mBufferSize = 0;
+    }
+
+    void Hasher64::update(const void * iBuffer, size_t iSize)
+    {
+      const unsigned char * buffer = (const unsigned char *)iBuffer;
+      mTotalSize += iSize;
+
+      //complete the pending stripe
+      if (mBufferSize > 0)
+      {
+        size_t count = sizeof(mBuffer) - mBufferSize;
+        if (count > iSize)
+          count = iSize;
+        memcpy(mBuffer + mBufferSize, buffer, count);
+        mBufferSize += count;
+        buffer += count;
+        iSize -= count;
+        if (mBufferSize < sizeof(mBuffer))
+          return;
+        xxh64Stripes(mAccumulators, mBuffer, sizeof(mBuffer));
+        mBufferSize = 0;
+      }
+
+      //process full stripes directly from the input buffer
+      size_t processed = xxh64Stripes(mAccumulators, buffer, iSize);
+      mBufferSize = iSize - processed;
+      if (mBufferSize > 0)
+        memcpy(mBuffer, buffer + processed, mBufferSize);
+    }
+
+    void Hasher64::update(const std::string & iValue)
+    {
+      update(iValue.data(), iValue.size());
+    }
+
+    uint64_t Hasher64::digest() const
+    {
+      uint64_t hash;
+      if (mTotalSize >= 32)
+        hash = xxh64Converge(mAccumulators);
+      else
+        hash = mSeed + PRIME64_5;
+      hash += mTotalSize;
+      return xxh64Finalize(hash, mBuffer, mBufferSize);
+    }
+
+    //Lookup table of the CRC-32C (Castagnoli) polynomial 0x82F63B78 (reversed).
+    static const uint32_t gCrc32cTable[256] = {
+      0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C, 0x26A1E7E8, 0xD4CA64EB,
+      0x8AD958CF, 0x78B2DBCC, 0x6BE22838, 0x9989AB3B, 0x4D43CFD0, 0xBF284CD3, 0xAC78BF27, 0x5E133C24,
+      0x105EC76F, 0xE235446C, 0xF165B798, 0x030E349B, 0xD7C45070, 0x25AFD373, 0x36FF2087, 0xC494A384,
+      0x9A879FA0, 0x68EC1CA3, 0x7BBCEF57, 0x89D76C54, 0x5D1D08BF, 0xAF768BBC, 0xBC267848, 0x4E4DFB4B,
+      0x20BD8EDE, 0xD2D60DDD, 0xC186FE29, 0x33ED7D2A, 0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35,
+      0xAA64D611, 0x580F5512, 0x4B5FA6E6, 0xB93425E5, 0x6DFE410E, 0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA,
+      0x30E349B1, 0xC288CAB2, 0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD, 0x1642AE59, 0xE4292D5A,
+      0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A, 0x7DA08661, 0x8FCB0562, 0x9C9BF696, 0x6EF07595,
+      0x417B1DBC, 0xB3109EBF, 0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0, 0x67DAFA54, 0x95B17957,
+      0xCBA24573, 0x39C9C670, 0x2A993584, 0xD8F2B687, 0x0C38D26C, 0xFE53516F, 0xED03A29B, 0x1F682198,
+      0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927, 0x96BF4DCC, 0x64D4CECF, 0x77843D3B, 0x85EFBE38,
+      0xDBFC821C, 0x2997011F, 0x3AC7F2EB, 0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4, 0x0F36E6F7,
+      0x61C69362, 0x93AD1061, 0x80FDE395, 0x72966096, 0xA65C047D, 0x5437877E, 0x4767748A, 0xB50CF789,
+      0xEB1FCBAD, 0x197448AE, 0x0A24BB5A, 0xF84F3859, 0x2C855CB2, 0xDEEEDFB1, 0xCDBE2C45, 0x3FD5AF46,
+      0x7198540D, 0x83F3D70E, 0x90A324FA, 0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5, 0xA55230E6,
+      0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD, 0xCEB018DE, 0xDDE0EB2A, 0x2F8B6829,
+      0x82F63B78, 0x709DB87B, 0x63CD4B8F, 0x91A6C88C, 0x456CAC67, 0xB7072F64, 0xA457DC90, 0x563C5F93,
+      0x082F63B7, 0xFA44E0B4, 0xE9141340, 0x1B7F9043, 0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C,
+      0x92A8FC17, 0x60C37F14, 0x73938CE0, 0x81F80FE3, 0x55326B08, 0xA759E80B, 0xB4091BFF, 0x466298FC,
+      0x1871A4D8, 0xEA1A27DB, 0xF94AD42F, 0x0B21572C, 0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033,
+      0xA24BB5A6, 0x502036A5, 0x4370C551, 0xB11B4652, 0x65D122B9, 0x97BAA1BA, 0x84EA524E, 0x7681D14D,
+      0x2892ED69, 0xDAF96E6A, 0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975, 0x0E330A81, 0xFC588982,
+      0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D, 0x758FE5D6, 0x87E466D5, 0x94B49521, 0x66DF1622,
+      0x38CC2A06, 0xCAA7A905, 0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19, 0x0D3D3E1A, 0x1E6DCDEE, 0xEC064EED,
+      0xC38D26C4, 0x31E6A5C7, 0x22B65633, 0xD0DDD530, 0x0417B1DB, 0xF67C32D8, 0xE52CC12C, 0x1747422F,
+      0x49547E0B, 0xBB3FFD08, 0xA86F0EFC, 0x5A048DFF, 0x8ECEE914, 0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0,
+      0xD3D3E1AB, 0x21B862A8, 0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643, 0x07198540,
+      0x590AB964, 0xAB613A67, 0xB831C993, 0x4A5A4A90, 0x9E902E7B, 0x6CFBAD78, 0x7FAB5E8C, 0x8DC0DD8F,
+      0xE330A81A, 0x115B2B19, 0x020BD8ED, 0xF0605BEE, 0x24AA3F05, 0xD6C1BC06, 0xC5914FF2, 0x37FACCF1,
+      0x69E9F0D5, 0x9B8273D6, 0x88D28022, 0x7AB90321, 0xAE7367CA, 0x5C18E4C9, 0x4F48173D, 0xBD23943E,
+      0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A, 0xC69F7B69, 0xD5CF889D, 0x27A40B9E,
+      0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E, 0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351
+    };
+
+    uint32_t crc32cSoftware(uint32_t iCrc, const unsigned char * iBuffer, size_t iSize)
+    {
+      for(size_t i=0; i<iSize; i++)
+      {
+        iCrc = gCrc32cTable[(iCrc ^ iBuffer[i]) & 0xFF] ^ (iCrc >> 8);
+      }
+      return iCrc;
+    }
+
+#ifdef RA_HASH_CRC32C_X86
+#ifdef _MSC_VER
+    bool detectCrc32cInstruction()
+    {
+      int info[4];
+      __cpuid(info, 1);
+      return (info[2] & (1 << 20)) != 0; //SSE4.2
+    }
+
+    uint32_t crc32cHardware(uint32_t iCrc, const unsigned char * iBuffer, size_t iSize)
+    {
+#ifdef RA_HASH_X64
+      uint64_t crc = iCrc;
+      for(; iSize >= 8; iSize -= 8, iBuffer += 8)
+      {
+        crc = _mm_crc32_u64(crc, read64(iBuffer));
+      }
+      iCrc = (uint32_t)crc;
+#endif
+      for(; iSize >= 4; iSize -= 4, iBuffer += 4)
+      {
+        iCrc = _mm_crc32_u32(iCrc, read32(iBuffer));
+      }
+      for(; iSize > 0; iSize--, iBuffer++)
+      {
+        iCrc = _mm_crc32_u8(iCrc, *iBuffer);
+      }
+      return iCrc;
+    }
+#else
+    bool detectCrc32cInstruction()
+    {
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sse4.2") != 0;
+    }
+
+    //The function is compiled for SSE 4.2 regardless of the compiler flags. It is only called when supported by the processor.
+    __attribute__((target("sse4.2")))
+    uint32_t crc32cHardware(uint32_t iCrc, const unsigned char * iBuffer, size_t iSize)
+    {
+#ifdef RA_HASH_X64
+      unsigned long long crc = iCrc;
+      for(; iSize >= 8; iSize -= 8, iBuffer += 8)
+      {
+        crc = __builtin_ia32_crc32di(crc, read64(iBuffer));
+      }
+      iCrc = (uint32_t)crc;
+#endif
+      for(; iSize >= 4; iSize -= 4, iBuffer += 4)
+      {
+        iCrc = __builtin_ia32_crc32si(iCrc, read32(iBuffer));
+      }
+      for(; iSize > 0; iSize--, iBuffer++)
+      {
+        iCrc = __builtin_ia32_crc32qi(iCrc, *iBuffer);
+      }
+      return iCrc;
+    }
+#endif //_MSC_VER
+
+    static const bool gCrc32cAccelerated = detectCrc32cInstruction();
+#else
+    static const bool gCrc32cAccelerated = false;
+#endif //RA_HASH_CRC32C_X86
+
+    uint32_t crc32c(const void * iBuffer, size_t iSize, uint32_t iCrc)
+    {
+      const unsigned char * buffer = (const unsigned char *)iBuffer;
+      uint32_t crc = ~iCrc;
+#ifdef RA_HASH_CRC32C_X86
+      if (gCrc32cAccelerated)
+        crc = crc32cHardware(crc, buffer, iSize);
+      else
+#endif
+        crc = crc32cSoftware(crc, buffer, iSize);
+      return ~crc;
+    }
+
+    uint32_t crc32c(const std::string & iValue)
+    {
+      return crc32c(iValue.data(), iValue.size());
+    }
+
+    bool isCrc32cAccelerated()
+    {
+      return gCrc32cAccelerated;
+    }
+
+  } //namespace hash
+} //namespace ra
@@ -23,11 +23,10 @@
  *********************************************************************************/
 
 #include "rapidassist/logger.h"
+#include "rapidassist/strings.h"
 
-#include <sstream>
 #include <stdarg.h> //for functions with "..." arguments
-#include <cstdlib> //for printf()
-#include <cstdio> //for vsnprintf()
+#include <cstdio> //for printf()
 
 namespace ra
 {
@@ -51,16 +50,10 @@ namespace ra
       if (iFormat == NULL)
         return;
 
-      std::string logstring;
-
       //convert arguments to a single string
       va_list args;
       va_start(args, iFormat);
-      static const int BUFFER_SIZE = 10240;
-      char buffer[BUFFER_SIZE];
-      buffer[0] = '\0';
-      vsnprintf(buffer, BUFFER_SIZE, iFormat, args);
-      logstring = buffer;
+      std::string logstring = ra::strings::vformat(iFormat, args);
       va_end (args);
 
       //print the single string to the console
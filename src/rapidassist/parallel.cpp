@@ -0,0 +1,173 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "parallel.h"
+
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
+#endif /* WIN32_LEAN_AND_MEAN */
+#include <Windows.h>
+#include <process.h> //for _beginthreadex()
+#else
+#include <pthread.h>
+#include <unistd.h> //for sysconf()
+#endif
+
+namespace ra
+{
+  namespace parallel
+  {
+
+#ifdef _WIN32
+    Mutex::Mutex()
+    {
+      CRITICAL_SECTION * handle = new CRITICAL_SECTION();
+      InitializeCriticalSection(handle);
+      mHandle = handle;
+    }
+
+    Mutex::~Mutex()
+    {
+      CRITICAL_SECTION * handle = (CRITICAL_SECTION *)mHandle;
+      DeleteCriticalSection(handle);
+      delete handle;
+    }
+
+    void Mutex::lock()
+    {
+      EnterCriticalSection((CRITICAL_SECTION *)mHandle);
+    }
+
+    void Mutex::unlock()
+    {
+      LeaveCriticalSection((CRITICAL_SECTION *)mHandle);
+    }
+#else
+    Mutex::Mutex()
+    {
+      pthread_mutex_t * handle = new pthread_mutex_t();
+      pthread_mutex_init(handle, NULL);
+      mHandle = handle;
+    }
+
+    Mutex::~Mutex()
+    {
+      pthread_mutex_t * handle = (pthread_mutex_t *)mHandle;
+      pthread_mutex_destroy(handle);
+      delete handle;
+    }
+
+    void Mutex::lock()
+    {
+      pthread_mutex_lock((pthread_mutex_t *)mHandle);
+    }
+
+    void Mutex::unlock()
+    {
+      pthread_mutex_unlock((pthread_mutex_t *)mHandle);
+    }
+#endif
+
+    size_t getNumProcessors()
+    {
+#ifdef _WIN32
+      SYSTEM_INFO info;
+      GetSystemInfo(&info);
+      return (info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1);
+#else
+      long count = sysconf(_SC_NPROCESSORS_ONLN);
+      return (count > 0 ? (size_t)count : 1);
+#endif
+    }
+
+    struct THREAD_TASK
+    {
+      TASK_FUNCTION function;
+      void * task;
+    };
+
+#ifdef _WIN32
+    unsigned __stdcall runThreadTask(void * iData)
+#else
+    void * runThreadTask(void * iData)
+#endif
+    {
+      THREAD_TASK * data = (THREAD_TASK *)iData;
+      data->function(data->task);
+      return 0;
+    }
+
+    void runTasks(TASK_FUNCTION iFunction, void ** iTasks, size_t iCount)
+    {
+      if (iCount == 0)
+        return;
+
+      std::vector<THREAD_TASK> tasks(iCount);
+#ifdef _WIN32
+      std::vector<HANDLE> threads(iCount, (HANDLE)NULL);
+#else
+      std::vector<pthread_t> threads(iCount);
+      std::vector<bool> started(iCount, false);
+#endif
+
+      //start all tasks but the first one
+      for(size_t i=1; i<iCount; i++)
+      {
+        tasks[i].function = iFunction;
+        tasks[i].task = iTasks[i];
+#ifdef _WIN32
+        threads[i] = (HANDLE)_beginthreadex(NULL, 0, &runThreadTask, &tasks[i], 0, NULL);
+        if (threads[i] == NULL)
+          iFunction(iTasks[i]);
+#else
+        started[i] = (pthread_create(&threads[i], NULL, &runThreadTask, &tasks[i]) == 0);
+        if (!started[i])
+          iFunction(iTasks[i]);
+#endif
+      }
+
+      //run the first task on the calling thread
+      iFunction(iTasks[0]);
+
+      //wait for the other tasks
+      for(size_t i=1; i<iCount; i++)
+      {
+#ifdef _WIN32
+        if (threads[i] != NULL)
+        {
+          WaitForSingleObject(threads[i], INFINITE);
+          CloseHandle(threads[i]);
+        }
+#else
+        if (started[i])
+          pthread_join(threads[i], NULL);
+#endif
+      }
+    }
+
+  } //namespace parallel
+} //namespace ra
@@ -0,0 +1,89 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#ifndef RA_PARALLEL_H
+#define RA_PARALLEL_H
+
+#include <stddef.h> //for size_t
+
+//Private helpers for multithreading within the library. This header is not installed.
+
+namespace ra
+{
+  namespace parallel
+  {
+
+    /// <summary>
+    /// A platform mutex: CRITICAL_SECTION on Windows, pthread_mutex_t on other platforms.
+    /// </summary>
+    class Mutex
+    {
+    public:
+      Mutex();
+      ~Mutex();
+      void lock();
+      void unlock();
+
+    private:
+      //disable copy
+      Mutex(const Mutex &);
+      Mutex & operator=(const Mutex &);
+
+      void * mHandle;
+    };
+
+    /// <summary>
+    /// Locks a mutex for the lifetime of the object.
+    /// </summary>
+    class MutexLock
+    {
+    public:
+      MutexLock(Mutex & iMutex) : mMutex(iMutex) { mMutex.lock(); }
+      ~MutexLock() { mMutex.unlock(); }
+
+    private:
+      Mutex & mMutex;
+    };
+
+    /// <summary>
+    /// Returns the number of processors available to the current process. Returns 1 if unknown.
+    /// </summary>
+    size_t getNumProcessors();
+
+    typedef void (*TASK_FUNCTION)(void * iTask);
+
+    /// <summary>
+    /// Runs iFunction on each task concurrently and waits for all tasks to complete.
+    /// The first task runs on the calling thread. Each other task runs on its own thread.
+    /// If a thread cannot be created, its task runs on the calling thread.
+    /// </summary>
+    /// <param name="iFunction">The function to run for each task.</param>
+    /// <param name="iTasks">The argument of each call to iFunction.</param>
+    /// <param name="iCount">The number of tasks.</param>
+    void runTasks(TASK_FUNCTION iFunction, void ** iTasks, size_t iCount);
+
+  } //namespace parallel
+} //namespace ra
+
+#endif //RA_PARALLEL_H
@@ -25,418 +25,2433 @@
 #include "rapidassist/strings.h"
 #include "rapidassist/environment.h"
 #include "rapidassist/generics.h"
+#include "rapidassist/hash.h"
+#include "parallel.h"
 
-#include <sstream>  //for std::stringstream
 #include <string.h> //for strlen()
 #include <limits>   //for std::numeric_limits
 #include <stdarg.h> //for ...
 #include <stdio.h>  //for vsnprintf()
+#include <stdlib.h> //for strtod()
+#include <errno.h>  //for ERANGE
+#include <float.h>  //for FLT_MAX
+#include <math.h>   //for HUGE_VAL
+#include <locale.h> //for localeconv()
+#include <algorithm> //for std::sort()
+
+#ifndef va_copy
+#  ifdef __va_copy
+#    define va_copy(dest, src) __va_copy(dest, src)
+#  else
+#    define va_copy(dest, src) ((dest) = (src))
+#  endif
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RA_STRINGS_SSE2
+#include <emmintrin.h> //for SSE2 intrinsics
+#endif
+
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define RA_STRINGS_LITTLE_ENDIAN
+#endif
 
 namespace ra
 {
 
-  namespace strings
-  {
-    template <class T>
-    inline bool parseValueT (const std::string& str, T & t)
+  namespace strings
+  {
+    //Lookup table of all 2 digits decimal numbers. Converting two digits at a time halves the number of divisions.
+    static const char gDigitPairs[] =
+      "00010203040506070809"
+      "10111213141516171819"
+      "20212223242526272829"
+      "30313233343536373839"
+      "40414243444546474849"
+      "50515253545556575859"
+      "60616263646566676869"
+      "70717273747576777879"
+      "80818283848586878889"
+      "90919293949596979899";
+
+    template <class T>
+    inline size_t toCharsUnsignedT(char * oBuffer, T value)
+    {
+      //write digits backward in a temporary buffer
+      char tmp[TOCHARS_BUFFER_SIZE];
+      char * first = tmp + TOCHARS_BUFFER_SIZE;
+      while(value >= 100)
+      {
+        size_t index = (size_t)(value % 100) * 2;
+        value /= 100;
+        first -= 2;
+        first[0] = gDigitPairs[index];
+        first[1] = gDigitPairs[index+1];
+      }
+      if (value >= 10)
+      {
+        size_t index = (size_t)value * 2;
+        first -= 2;
+        first[0] = gDigitPairs[index];
+        first[1] = gDigitPairs[index+1];
+      }
+      else
+      {
+        first--;
+        first[0] = (char)('0' + value);
+      }
+
+      size_t length = (tmp + TOCHARS_BUFFER_SIZE) - first;
+      memcpy(oBuffer, first, length);
+      oBuffer[length] = '\0';
+      return length;
+    }
+
+    template <class T, class U>
+    inline size_t toCharsSignedT(char * oBuffer, T value)
+    {
+      if (value < 0)
+      {
+        //compute the magnitude as unsigned to support the minimum value of T
+        oBuffer[0] = '-';
+        U magnitude = (U)0 - (U)value;
+        return 1 + toCharsUnsignedT<U>(oBuffer+1, magnitude);
+      }
+      return toCharsUnsignedT<U>(oBuffer, (U)value);
+    }
+
+    //Returns the decimal point character of the current LC_NUMERIC locale.
+    inline char getLocaleDecimalPoint()
+    {
+      const struct lconv * lc = localeconv();
+      if (lc == NULL || lc->decimal_point == NULL || lc->decimal_point[0] == '\0')
+        return '.';
+      return lc->decimal_point[0];
+    }
+
+    template <class T>
+    inline size_t toCharsFloatT(char * oBuffer, const T & value, int iMinPrecision, int iMaxPrecision)
+    {
+      //find the shortest precision which converts back to the same value
+      int length = 0;
+      for(int precision = iMinPrecision; precision <= iMaxPrecision; precision++)
+      {
+        length = sprintf(oBuffer, "%.*g", precision, (double)value);
+        if (precision == iMaxPrecision || (T)strtod(oBuffer, NULL) == value || value != value /*nan*/)
+          break;
+      }
+
+      //sprintf() and strtod() use the decimal point of the current locale. Always output a '.' character.
+      const char decimalPoint = getLocaleDecimalPoint();
+      if (decimalPoint != '.')
+      {
+        char * point = (char *)memchr(oBuffer, decimalPoint, (size_t)length);
+        if (point != NULL)
+          *point = '.';
+      }
+      return (size_t)length;
+    }
+
+    //Note: http://www.parashift.com/c++-faq-lite/misc-technical-issues.html#faq-39.2
+    template <class T>
+    inline std::string toStringT (const T & t)
+    {
+      char buffer[TOCHARS_BUFFER_SIZE];
+      size_t length = toChars(buffer, t);
+      return std::string(buffer, length);
+    }
+
+    //template <class T>
+    //inline void toT (const char * iValue, T & t)
+    //{
+    //  std::string tmpString = iValue;
+    //  std::istringstream inputStream(tmpString);
+    //  inputStream >> t;
+    //}
+
+    //template<>
+    //inline void toT<unsigned char>(const char * iValue, unsigned char & t)
+    //{
+    //  std::string tmpString = iValue;
+    //  std::istringstream inputStream(tmpString);
+    //  uint16 tmp = 0;
+    //  inputStream >> tmp;
+    //  t = (unsigned char)tmp;
+    //}
+    //template<>
+    //inline void toT<char>(const char * iValue, char & t)
+    //{
+    //  std::string tmpString = iValue;
+    //  std::istringstream inputStream(tmpString);
+    //  sint16 tmp = 0;
+    //  inputStream >> tmp;
+    //  t = (char)tmp;
+    //}
+
+    //Returns a pointer to the first occurrence of iPattern within [iFirst, iLast). Returns NULL if not found.
+    inline const char * findPattern(const char * iFirst, const char * iLast, const StringRef & iPattern)
+    {
+      const size_t patternSize = iPattern.size();
+      const char firstCharacter = iPattern[0];
+      while(iFirst != NULL && (size_t)(iLast - iFirst) >= patternSize)
+      {
+        //memchr() is vectorized by the c runtime which makes it the fastest way to locate the next candidate
+        const char * candidate = (const char *)memchr(iFirst, firstCharacter, (iLast - iFirst) - patternSize + 1);
+        if (candidate == NULL)
+          return NULL;
+        if (memcmp(candidate+1, iPattern.data()+1, patternSize-1) == 0)
+          return candidate;
+        iFirst = candidate+1;
+      }
+      return NULL;
+    }
+
+    inline bool isDigit(char c)
+    {
+      return (unsigned char)(c - '0') <= 9;
+    }
+
+    //Returns a pointer to the first character in [iFirst, iLast) which is not a decimal digit.
+    inline const char * skipDigits(const char * iFirst, const char * iLast)
+    {
+#ifdef RA_STRINGS_SSE2
+      //bytes in ['0', '9'] are moved to [-128, -119] so that a single signed comparison identifies them
+      const __m128i offset = _mm_set1_epi8((char)('0' + 128));
+      const __m128i limit = _mm_set1_epi8(-118);
+      while(iLast - iFirst >= 16)
+      {
+        __m128i chunk = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)iFirst), offset);
+        int mask = _mm_movemask_epi8(_mm_cmplt_epi8(chunk, limit));
+        if (mask != 0xFFFF)
+        {
+          //find first non digit
+          for(int j=0; j<16; j++)
+          {
+            if ((mask & (1 << j)) == 0)
+              return iFirst + j;
+          }
+        }
+        iFirst += 16;
+      }
+#endif
+      while(iFirst != iLast && isDigit(*iFirst))
+        iFirst++;
+      return iFirst;
+    }
+
+    bool isNumeric(const char * iValue)
+    {
+      if (iValue == NULL)
+        return false;
+      return isNumeric(StringRef(iValue, strlen(iValue)), false);
+    }
+
+    bool isNumeric(const StringRef & iValue, bool iAllowExponent)
+    {
+      const char * first = iValue.begin();
+      const char * last = iValue.end();
+
+      //optional sign
+      if (first != last && (*first == '+' || *first == '-'))
+        first++;
+
+      //integer part
+      const char * digits = skipDigits(first, last);
+      size_t numDigits = (digits - first);
+      first = digits;
+
+      //fractional part
+      if (first != last && *first == '.')
+      {
+        first++;
+        digits = skipDigits(first, last);
+        numDigits += (digits - first);
+        first = digits;
+      }
+
+      //at least one digit is required
+      if (numDigits == 0)
+        return false;
+
+      //exponent
+      if (iAllowExponent && first != last && (*first == 'e' || *first == 'E'))
+      {
+        first++;
+        if (first != last && (*first == '+' || *first == '-'))
+          first++;
+        digits = skipDigits(first, last);
+        if (digits == first)
+          return false;
+        first = digits;
+      }
+
+      return (first == last);
+    }
+
+    size_t isNumericBatch(const StringRef * iValues, size_t iCount, uint8_t * oBitmap, bool iAllowExponent)
+    {
+      if (iValues == NULL || oBitmap == NULL)
+        return 0;
+
+      size_t numNumeric = 0;
+      for(size_t i = 0; i < iCount; i += 8)
+      {
+        //build a full byte of results before writing to the bitmap
+        uint8_t bits = 0;
+        size_t count = (iCount - i < 8 ? iCount - i : 8);
+        for(size_t j = 0; j < count; j++)
+        {
+          if (isNumeric(iValues[i + j], iAllowExponent))
+          {
+            bits |= (uint8_t)(1 << j);
+            numNumeric++;
+          }
+        }
+        oBitmap[i / 8] = bits;
+      }
+      return numNumeric;
+    }
+
+    int strReplace(std::string & iString, const char * iOldValue, const char * iNewValue)
+    {
+      const StringRef oldValue = iOldValue;
+      const StringRef newValue = iNewValue;
+      if (oldValue.empty() || iString.empty())
+        return 0;
+
+      //same length replacements are processed in place
+      if (oldValue.size() == newValue.size())
+      {
+        int numOccurance = 0;
+        char * first = &iString[0];
+        char * last = first + iString.size();
+        const char * match = findPattern(first, last, oldValue);
+        while(match != NULL)
+        {
+          char * position = first + (match - first); //non-const alias of match
+          memcpy(position, newValue.data(), newValue.size());
+          numOccurance++;
+          match = findPattern(position + oldValue.size(), last, oldValue);
+        }
+        return numOccurance;
+      }
+
+      std::string output;
+      int numOccurance = strReplace(output, iString, iOldValue, iNewValue);
+      if (numOccurance > 0)
+        iString.swap(output);
+      return numOccurance;
+    }
+
+    int strReplace(std::string & oOutput, const std::string & iString, const char * iOldValue, const char * iNewValue)
+    {
+      oOutput.clear();
+
+      const StringRef oldValue = iOldValue;
+      const StringRef newValue = iNewValue;
+      const char * first = iString.data();
+      const char * last = first + iString.size();
+
+      //first pass: count occurrences to compute the exact output size
+      size_t numOccurance = 0;
+      if (!oldValue.empty())
+      {
+        const char * match = findPattern(first, last, oldValue);
+        while(match != NULL)
+        {
+          numOccurance++;
+          match = findPattern(match + oldValue.size(), last, oldValue);
+        }
+      }
+      if (numOccurance == 0)
+      {
+        oOutput = iString;
+        return 0;
+      }
+
+      //second pass: build the output in a single allocation
+      oOutput.resize(iString.size() - numOccurance*oldValue.size() + numOccurance*newValue.size());
+      char * output = &oOutput[0];
+      const char * match = findPattern(first, last, oldValue);
+      while(match != NULL)
+      {
+        size_t length = match - first;
+        memcpy(output, first, length);
+        output += length;
+        memcpy(output, newValue.data(), newValue.size());
+        output += newValue.size();
+        first = match + oldValue.size();
+        match = findPattern(first, last, oldValue);
+      }
+      memcpy(output, first, last - first);
+
+      return (int)numOccurance;
+    }
+
+    int strReplace(std::string & iString, const StringVector & iOldValues, const StringVector & iNewValues)
+    {
+      StringReplacer replacer;
+      for(size_t i=0; i<iOldValues.size() && i<iNewValues.size(); i++)
+      {
+        replacer.add(iOldValues[i], iNewValues[i]);
+      }
+      return replacer.replace(iString);
+    }
+
+    struct REPLACEMENT_MATCH
+    {
+      size_t offset; //offset of the match in the input text
+      int value;     //index of the matching replacement
+    };
+
+    StringReplacer::StringReplacer()
+    {
+      clear();
+    }
+
+    void StringReplacer::clear()
+    {
+      mOldValues.clear();
+      mNewValues.clear();
+      mNodeValues.assign(1, -1);
+      mAlphabet.assign(256, 0);
+      mAlphabetSize = 1;
+      mTransitions.assign(1, 0);
+    }
+
+    void StringReplacer::add(const StringRef & iOldValue, const StringRef & iNewValue)
+    {
+      if (iOldValue.empty())
+        return;
+
+      //register the new bytes of the old value in the alphabet
+      size_t alphabetSize = mAlphabetSize;
+      for(size_t i=0; i<iOldValue.size(); i++)
+      {
+        int & column = mAlphabet[(unsigned char)iOldValue[i]];
+        if (column == 0)
+          column = (int)alphabetSize++;
+      }
+      if (alphabetSize != mAlphabetSize)
+      {
+        //widen the rows of all existing nodes
+        const size_t numNodes = mNodeValues.size();
+        std::vector<int> transitions(numNodes * alphabetSize, 0);
+        for(size_t node=0; node<numNodes; node++)
+        {
+          memcpy(&transitions[node*alphabetSize], &mTransitions[node*mAlphabetSize], mAlphabetSize*sizeof(int));
+        }
+        mTransitions.swap(transitions);
+        mAlphabetSize = alphabetSize;
+      }
+
+      //insert the old value in the trie
+      int node = 0;
+      for(size_t i=0; i<iOldValue.size(); i++)
+      {
+        const size_t column = (size_t)mAlphabet[(unsigned char)iOldValue[i]];
+        int & child = mTransitions[node*mAlphabetSize + column];
+        if (child == 0)
+        {
+          //note that the child reference is invalidated when mTransitions grows
+          int newNode = (int)mNodeValues.size();
+          child = newNode;
+          mNodeValues.push_back(-1);
+          mTransitions.resize(mTransitions.size() + mAlphabetSize, 0);
+        }
+        node = mTransitions[node*mAlphabetSize + column];
+      }
+
+      //the first registered value wins over duplicates
+      if (mNodeValues[node] == -1)
+      {
+        mNodeValues[node] = (int)mNewValues.size();
+        mOldValues.push_back(iOldValue.toString());
+        mNewValues.push_back(iNewValue.toString());
+      }
+    }
+
+    int StringReplacer::replace(std::string & oOutput, const StringRef & iText) const
+    {
+      oOutput.clear();
+
+      std::vector<REPLACEMENT_MATCH> matches;
+
+      //single scan: find the longest value that starts at each position
+      const unsigned char * text = (const unsigned char *)iText.data();
+      const size_t size = iText.size();
+      const int * transitions = &mTransitions[0];
+      const int * alphabet = &mAlphabet[0];
+      const size_t alphabetSize = mAlphabetSize;
+      size_t outputSize = size;
+      size_t i = 0;
+      while(i < size)
+      {
+        //quickly skip characters that cannot start a value
+        if (transitions[alphabet[text[i]]] == 0)
+        {
+          i++;
+          continue;
+        }
+
+        int node = 0;
+        int value = -1;
+        size_t length = 0;
+        for(size_t j=i; j<size; j++)
+        {
+          node = transitions[node*alphabetSize + alphabet[text[j]]];
+          if (node == 0)
+            break;
+          if (mNodeValues[node] != -1)
+          {
+            value = mNodeValues[node];
+            length = j - i + 1;
+          }
+        }
+
+        if (value == -1)
+        {
+          i++;
+          continue;
+        }
+
+        REPLACEMENT_MATCH m;
+        m.offset = i;
+        m.value = value;
+        matches.push_back(m);
+        outputSize = outputSize - length + mNewValues[value].size();
+        i += length;
+      }
+
+      if (matches.empty())
+      {
+        oOutput.assign(iText.data(), size);
+        return 0;
+      }
+
+      //write the output in a single allocation
+      oOutput.resize(outputSize);
+      char * output = &oOutput[0];
+      size_t position = 0;
+      for(size_t k=0; k<matches.size(); k++)
+      {
+        const REPLACEMENT_MATCH & m = matches[k];
+        const std::string & oldValue = mOldValues[m.value];
+        const std::string & newValue = mNewValues[m.value];
+        memcpy(output, iText.data() + position, m.offset - position);
+        output += m.offset - position;
+        memcpy(output, newValue.data(), newValue.size());
+        output += newValue.size();
+        position = m.offset + oldValue.size();
+      }
+      memcpy(output, iText.data() + position, size - position);
+
+      return (int)matches.size();
+    }
+
+    int StringReplacer::replace(std::string & ioString) const
+    {
+      std::string output;
+      int numOccurance = replace(output, ioString);
+      if (numOccurance > 0)
+        ioString.swap(output);
+      return numOccurance;
+    }
+
+    size_t toChars(char * oBuffer, const int8_t & value)
+    {
+      return toCharsSignedT<int8_t, uint8_t>(oBuffer, value);
+    }
+
+    size_t toChars(char * oBuffer, const uint8_t & value)
+    {
+      return toCharsUnsignedT<uint32_t>(oBuffer, value);
+    }
+
+    size_t toChars(char * oBuffer, const int16_t & value)
+    {
+      return toCharsSignedT<int16_t, uint16_t>(oBuffer, value);
+    }
+
+    size_t toChars(char * oBuffer, const uint16_t & value)
+    {
+      return toCharsUnsignedT<uint32_t>(oBuffer, value);
+    }
+
+    size_t toChars(char * oBuffer, const int32_t & value)
+    {
+      return toCharsSignedT<int32_t, uint32_t>(oBuffer, value);
+    }
+
+    size_t toChars(char * oBuffer, const uint32_t & value)
+    {
+      return toCharsUnsignedT<uint32_t>(oBuffer, value);
+    }
+
+    size_t toChars(char * oBuffer, const int64_t & value)
+    {
+      return toCharsSignedT<int64_t, uint64_t>(oBuffer, value);
+    }
+
+    size_t toChars(char * oBuffer, const uint64_t & value)
+    {
+      return toCharsUnsignedT<uint64_t>(oBuffer, value);
+    }
+
+    size_t toChars(char * oBuffer, const float & value)
+    {
+      return toCharsFloatT<float>(oBuffer, value, 6, 9);
+    }
+
+    size_t toChars(char * oBuffer, const double & value)
+    {
+      return toCharsFloatT<double>(oBuffer, value, 15, 17);
+    }
+
+#ifdef RA_STRINGS_LITTLE_ENDIAN
+    //SWAR (SIMD within a register) helpers which process 8 digits at once.
+    //See https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/
+
+    //Returns true if the 8 characters of the given little-endian word are all digits.
+    inline bool isEightDigits(uint64_t iWord)
+    {
+      return (((iWord & 0xF0F0F0F0F0F0F0F0ull) | (((iWord + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+    }
+
+    //Returns the value of the 8 digits of the given little-endian word.
+    inline uint64_t parseEightDigits(uint64_t iWord)
+    {
+      iWord -= 0x3030303030303030ull;
+      iWord = (iWord * 10) + (iWord >> 8);
+      iWord = (((iWord & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) + (((iWord >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+      return iWord;
+    }
+#endif
+
+    inline int getDigitValue(char c, int iBase)
+    {
+      if (c >= '0' && c <= '9')
+        return c - '0';
+      if (iBase == 16)
+      {
+        if (c >= 'a' && c <= 'f')
+          return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+          return c - 'A' + 10;
+      }
+      return -1;
+    }
+
+    //Parse the digits at the beginning of [iFirst, iLast) as an unsigned 64 bit value.
+    FROMCHARS_RESULT fromCharsMagnitude(const char * iFirst, const char * iLast, uint64_t & oValue, int iBase)
+    {
+      static const uint64_t UINT64_MAXIMUM = std::numeric_limits<uint64_t>::max();
+      FROMCHARS_RESULT result;
+      result.ptr = iFirst;
+      result.error = FROMCHARS_INVALID_ARGUMENT;
+      if (iBase != 10 && iBase != 16)
+        return result;
+
+      const char * p = iFirst;
+      uint64_t value = 0;
+
+#ifdef RA_STRINGS_LITTLE_ENDIAN
+      //consume 8 digits at a time while value*10^8 + 99999999 cannot overflow
+      if (iBase == 10)
+      {
+        while(iLast - p >= 8 && value < 100000000000ull)
+        {
+          uint64_t word;
+          memcpy(&word, p, sizeof(word));
+          if (!isEightDigits(word))
+            break;
+          value = value * 100000000ull + parseEightDigits(word);
+          p += 8;
+        }
+      }
+#endif
+
+      bool overflow = false;
+      const uint64_t base = (uint64_t)iBase;
+      while(p != iLast)
+      {
+        int digit = getDigitValue(*p, iBase);
+        if (digit < 0)
+          break;
+        if (value > (UINT64_MAXIMUM - (uint64_t)digit) / base)
+          overflow = true; //keep consuming digits
+        else
+          value = value * base + (uint64_t)digit;
+        p++;
+      }
+
+      if (p == iFirst)
+        return result;
+      result.ptr = p;
+      if (overflow)
+      {
+        result.error = FROMCHARS_OUT_OF_RANGE;
+        return result;
+      }
+      result.error = FROMCHARS_SUCCESS;
+      oValue = value;
+      return result;
+    }
+
+    template <class T>
+    inline FROMCHARS_RESULT fromCharsUnsignedT(const char * iFirst, const char * iLast, T & oValue, int iBase)
+    {
+      uint64_t magnitude = 0;
+      FROMCHARS_RESULT result = fromCharsMagnitude(iFirst, iLast, magnitude, iBase);
+      if (result.error != FROMCHARS_SUCCESS)
+        return result;
+      if (magnitude > (uint64_t)std::numeric_limits<T>::max())
+      {
+        result.error = FROMCHARS_OUT_OF_RANGE;
+        return result;
+      }
+      oValue = (T)magnitude;
+      return result;
+    }
+
+    template <class T>
+    inline FROMCHARS_RESULT fromCharsSignedT(const char * iFirst, const char * iLast, T & oValue, int iBase)
+    {
+      bool negative = (iFirst != iLast && *iFirst == '-');
+      uint64_t magnitude = 0;
+      FROMCHARS_RESULT result = fromCharsMagnitude(negative ? iFirst+1 : iFirst, iLast, magnitude, iBase);
+      if (result.error == FROMCHARS_INVALID_ARGUMENT)
+      {
+        result.ptr = iFirst;
+        return result;
+      }
+      if (result.error != FROMCHARS_SUCCESS)
+        return result;
+
+      //the magnitude of the minimum value is one more than the maximum value
+      const uint64_t limit = (uint64_t)std::numeric_limits<T>::max() + (negative ? 1 : 0);
+      if (magnitude > limit)
+      {
+        result.error = FROMCHARS_OUT_OF_RANGE;
+        return result;
+      }
+      if (negative)
+        oValue = (T)(0 - (int64_t)(magnitude - 1) - 1);
+      else
+        oValue = (T)magnitude;
+      return result;
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, int8_t & oValue, int iBase)
+    {
+      return fromCharsSignedT(iFirst, iLast, oValue, iBase);
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, uint8_t & oValue, int iBase)
+    {
+      return fromCharsUnsignedT(iFirst, iLast, oValue, iBase);
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, int16_t & oValue, int iBase)
+    {
+      return fromCharsSignedT(iFirst, iLast, oValue, iBase);
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, uint16_t & oValue, int iBase)
+    {
+      return fromCharsUnsignedT(iFirst, iLast, oValue, iBase);
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, int32_t & oValue, int iBase)
+    {
+      return fromCharsSignedT(iFirst, iLast, oValue, iBase);
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, uint32_t & oValue, int iBase)
+    {
+      return fromCharsUnsignedT(iFirst, iLast, oValue, iBase);
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, int64_t & oValue, int iBase)
+    {
+      return fromCharsSignedT(iFirst, iLast, oValue, iBase);
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, uint64_t & oValue, int iBase)
+    {
+      return fromCharsUnsignedT(iFirst, iLast, oValue, iBase);
+    }
+
+    //Returns true if [iFirst, iLast) starts with the given lowercase keyword, ignoring case.
+    inline bool startsWithKeyword(const char * iFirst, const char * iLast, const char * iKeyword)
+    {
+      for(; *iKeyword != '\0'; iFirst++, iKeyword++)
+      {
+        if (iFirst == iLast || (*iFirst | 0x20) != *iKeyword)
+          return false;
+      }
+      return true;
+    }
+
+    //Limits of the exact conversion and c runtime parsing function of each floating point type.
+    template <class T> struct FLOAT_TRAITS;
+    template <> struct FLOAT_TRAITS<float>
+    {
+      static const int MAX_EXACT_POWER = 10;                  //10^10 is the largest power of 10 representable as float
+      static uint64_t getMaxExactMantissa() { return 16777216ull; } //2^24
+      static float parse(const char * iValue) { return strtof(iValue, NULL); }
+    };
+    template <> struct FLOAT_TRAITS<double>
+    {
+      static const int MAX_EXACT_POWER = 22;                  //10^22 is the largest power of 10 representable as double
+      static uint64_t getMaxExactMantissa() { return 9007199254740992ull; } //2^53
+      static double parse(const char * iValue) { return strtod(iValue, NULL); }
+    };
+
+    template <class T>
+    inline FROMCHARS_RESULT fromCharsFloatT(const char * iFirst, const char * iLast, T & oValue)
+    {
+      //exact powers of 10 representable as double
+      static const double POWERS_OF_TEN[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+      };
+      const int MAX_EXACT_POWER = FLOAT_TRAITS<T>::MAX_EXACT_POWER;
+      const uint64_t MAX_EXACT_MANTISSA = FLOAT_TRAITS<T>::getMaxExactMantissa();
+
+      FROMCHARS_RESULT result;
+      result.ptr = iFirst;
+      result.error = FROMCHARS_INVALID_ARGUMENT;
+
+      const char * p = iFirst;
+      bool negative = (p != iLast && *p == '-');
+      if (negative)
+        p++;
+
+      //special values
+      if (startsWithKeyword(p, iLast, "inf"))
+      {
+        p += (startsWithKeyword(p, iLast, "infinity") ? 8 : 3);
+        oValue = (negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity());
+        result.ptr = p;
+        result.error = FROMCHARS_SUCCESS;
+        return result;
+      }
+      if (startsWithKeyword(p, iLast, "nan"))
+      {
+        oValue = std::numeric_limits<T>::quiet_NaN();
+        result.ptr = p + 3;
+        result.error = FROMCHARS_SUCCESS;
+        return result;
+      }
+
+      //mantissa
+      uint64_t mantissa = 0;
+      int numDigits = 0;    //number of significant digits stored in mantissa
+      int exponent = 0;     //decimal exponent to apply to mantissa
+      bool truncated = false;
+      bool foundDigits = false;
+      while(p != iLast && *p >= '0' && *p <= '9')
+      {
+        foundDigits = true;
+        if (numDigits < 19)
+        {
+          mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+          if (mantissa != 0)
+            numDigits++;
+        }
+        else
+        {
+          truncated |= (*p != '0');
+          exponent++;
+        }
+        p++;
+      }
+      if (p != iLast && *p == '.')
+      {
+        const char * dot = p;
+        p++;
+        while(p != iLast && *p >= '0' && *p <= '9')
+        {
+          foundDigits = true;
+          if (numDigits < 19)
+          {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            if (mantissa != 0)
+              numDigits++;
+            exponent--;
+          }
+          else
+          {
+            truncated |= (*p != '0');
+          }
+          p++;
+        }
+        if (p == dot + 1 && !foundDigits)
+          p = dot;
+      }
+      if (!foundDigits)
+        return result;
+
+      //exponent
+      if (p != iLast && (*p == 'e' || *p == 'E'))
+      {
+        const char * e = p + 1;
+        bool negativeExponent = false;
+        if (e != iLast && (*e == '+' || *e == '-'))
+        {
+          negativeExponent = (*e == '-');
+          e++;
+        }
+        if (e != iLast && *e >= '0' && *e <= '9')
+        {
+          int explicitExponent = 0;
+          while(e != iLast && *e >= '0' && *e <= '9')
+          {
+            if (explicitExponent < 100000)
+              explicitExponent = explicitExponent * 10 + (*e - '0');
+            e++;
+          }
+          exponent += (negativeExponent ? -explicitExponent : explicitExponent);
+          p = e;
+        }
+      }
+      result.ptr = p;
+
+      //fast path: both the mantissa and the power of 10 are exactly representable in T which guarantees a correctly rounded result
+      if (!truncated && mantissa <= MAX_EXACT_MANTISSA && exponent >= -MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER)
+      {
+        T value = (T)mantissa;
+        if (exponent < 0)
+          value /= (T)POWERS_OF_TEN[-exponent];
+        else
+          value *= (T)POWERS_OF_TEN[exponent];
+        oValue = (negative ? -value : value);
+        result.error = FROMCHARS_SUCCESS;
+        return result;
+      }
+
+      //slow path: let the c runtime round the value correctly
+      static const size_t BUFFER_SIZE = 128;
+      char buffer[BUFFER_SIZE];
+      std::string copy;
+      char * str = buffer;
+      size_t length = p - iFirst;
+      if (length < BUFFER_SIZE)
+      {
+        memcpy(buffer, iFirst, length);
+        buffer[length] = '\0';
+      }
+      else
+      {
+        copy.assign(iFirst, length);
+        str = &copy[0];
+      }
+
+      //strtod() and strtof() expect the decimal point of the current locale
+      const char decimalPoint = getLocaleDecimalPoint();
+      if (decimalPoint != '.')
+      {
+        char * point = (char *)memchr(str, '.', length);
+        if (point != NULL)
+          *point = decimalPoint;
+      }
+
+      errno = 0;
+      T value = FLOAT_TRAITS<T>::parse(str);
+      if (errno == ERANGE && (value == std::numeric_limits<T>::infinity() || value == -std::numeric_limits<T>::infinity()))
+      {
+        result.error = FROMCHARS_OUT_OF_RANGE;
+        return result;
+      }
+      oValue = value;
+      result.error = FROMCHARS_SUCCESS;
+      return result;
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, float & oValue)
+    {
+      return fromCharsFloatT(iFirst, iLast, oValue);
+    }
+
+    FROMCHARS_RESULT fromChars(const char * iFirst, const char * iLast, double & oValue)
+    {
+      return fromCharsFloatT(iFirst, iLast, oValue);
+    }
+
+    std::string toString(const uint64_t & value)
+    {
+      return toStringT(value);
+    }
+
+    bool parseValue(const std::string& str, uint64_t & oValue)
+    {
+      const char * first = str.c_str();
+      const char * last = first + str.size();
+      FROMCHARS_RESULT result = fromChars(first, last, oValue);
+      return (result.error == FROMCHARS_SUCCESS && result.ptr == last);
+    }
+
+    inline char toUpperAscii(char c)
+    {
+      return (c >= 'a' && c <= 'z' ? (char)(c - ('a' - 'A')) : c);
+    }
+
+    inline char toLowerAscii(char c)
+    {
+      return (c >= 'A' && c <= 'Z' ? (char)(c + ('a' - 'A')) : c);
+    }
+
+#ifdef RA_STRINGS_SSE2
+    //Flips the case bit (0x20) of all characters in the range [iFirst, iFirst+25] of the given 16 characters.
+    inline __m128i changeCaseSSE2(__m128i iValue, char iFirst)
+    {
+      //shift the range to [-128, -103] which allows a single signed comparison
+      const __m128i shifted = _mm_add_epi8(iValue, _mm_set1_epi8((char)(0x80 - iFirst)));
+      const __m128i inRange = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+      return _mm_xor_si128(iValue, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+    }
+#endif
+
+    //Converts the characters in the range [iFirst, iFirst+25] to the other case.
+    inline void changeCase(char * oBuffer, const char * iValue, size_t iSize, char iFirst)
+    {
+      size_t i = 0;
+#ifdef RA_STRINGS_SSE2
+      for(; i + 16 <= iSize; i += 16)
+      {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(iValue + i));
+        _mm_storeu_si128((__m128i *)(oBuffer + i), changeCaseSSE2(chunk, iFirst));
+      }
+#endif
+      for(; i < iSize; i++)
+      {
+        char c = iValue[i];
+        oBuffer[i] = (c >= iFirst && c <= iFirst + 25 ? (char)(c ^ 0x20) : c);
+      }
+    }
+
+    void uppercase(char * oBuffer, const char * iValue, size_t iSize)
+    {
+      changeCase(oBuffer, iValue, iSize, 'a');
+    }
+
+    void lowercase(char * oBuffer, const char * iValue, size_t iSize)
+    {
+      changeCase(oBuffer, iValue, iSize, 'A');
+    }
+
+    void uppercaseInPlace(std::string & ioValue)
+    {
+      if (ioValue.empty())
+        return;
+      char * buffer = &ioValue[0];
+      changeCase(buffer, buffer, ioValue.size(), 'a');
+    }
+
+    void lowercaseInPlace(std::string & ioValue)
+    {
+      if (ioValue.empty())
+        return;
+      char * buffer = &ioValue[0];
+      changeCase(buffer, buffer, ioValue.size(), 'A');
+    }
+
+    std::string capitalizeFirstCharacter(const std::string & iValue)
+    {
+      std::string copy = iValue;
+      if (!copy.empty())
+      {
+        copy[0] = toUpperAscii(copy[0]);
+      }
+      return copy;
+    }
+
+    std::string uppercase(const std::string & iValue)
+    {
+      std::string copy = iValue;
+      uppercaseInPlace(copy);
+      return copy;
+    }
+
+    std::string lowercase(const std::string & iValue)
+    {
+      std::string copy = iValue;
+      lowercaseInPlace(copy);
+      return copy;
+    }
+
+    //Returns the offset of the first character which is different (ignoring case) in a and b. Returns iSize if identical.
+    inline size_t mismatchIgnoreCase(const char * a, const char * b, size_t iSize)
+    {
+      size_t i = 0;
+#ifdef RA_STRINGS_SSE2
+      for(; i + 16 <= iSize; i += 16)
+      {
+        __m128i chunkA = changeCaseSSE2(_mm_loadu_si128((const __m128i *)(a + i)), 'A');
+        __m128i chunkB = changeCaseSSE2(_mm_loadu_si128((const __m128i *)(b + i)), 'A');
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunkA, chunkB));
+        if (mask != 0xFFFF)
+        {
+          //find first mismatch
+          for(size_t j=0; j<16; j++)
+          {
+            if ((mask & (1 << j)) == 0)
+              return i + j;
+          }
+        }
+      }
+#endif
+      for(; i < iSize; i++)
+      {
+        if (toLowerAscii(a[i]) != toLowerAscii(b[i]))
+          return i;
+      }
+      return iSize;
+    }
+
+    bool equalsIgnoreCase(const StringRef & a, const StringRef & b)
+    {
+      if (a.size() != b.size())
+        return false;
+      return mismatchIgnoreCase(a.data(), b.data(), a.size()) == a.size();
+    }
+
+    int compareIgnoreCase(const StringRef & a, const StringRef & b)
+    {
+      size_t size = (a.size() < b.size() ? a.size() : b.size());
+      size_t offset = mismatchIgnoreCase(a.data(), b.data(), size);
+      if (offset < size)
+      {
+        unsigned char ca = (unsigned char)toLowerAscii(a[offset]);
+        unsigned char cb = (unsigned char)toLowerAscii(b[offset]);
+        return (ca < cb ? -1 : 1);
+      }
+      if (a.size() == b.size())
+        return 0;
+      return (a.size() < b.size() ? -1 : 1);
+    }
+
+    size_t findIgnoreCase(const StringRef & iText, const StringRef & iValue, size_t iOffset)
+    {
+      if (iOffset > iText.size() || iValue.size() > iText.size() - iOffset)
+        return std::string::npos;
+      if (iValue.empty())
+        return iOffset;
+
+      const char * text = iText.data();
+      const char first = toLowerAscii(iValue[0]);
+      const size_t last = iText.size() - iValue.size(); //last offset where iValue can be found
+      size_t i = iOffset;
+#ifdef RA_STRINGS_SSE2
+      //find candidates 16 characters at a time
+      const __m128i firstChunk = _mm_set1_epi8(first);
+      for(; i + 16 <= last + 1; i += 16)
+      {
+        __m128i chunk = changeCaseSSE2(_mm_loadu_si128((const __m128i *)(text + i)), 'A');
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, firstChunk));
+        for(size_t j=0; mask != 0; j++, mask >>= 1)
+        {
+          if ((mask & 1) && mismatchIgnoreCase(text + i + j + 1, iValue.data() + 1, iValue.size() - 1) == iValue.size() - 1)
+            return i + j;
+        }
+      }
+#endif
+      for(; i <= last; i++)
+      {
+        if (toLowerAscii(text[i]) == first && mismatchIgnoreCase(text + i + 1, iValue.data() + 1, iValue.size() - 1) == iValue.size() - 1)
+          return i;
+      }
+      return std::string::npos;
+    }
+
+    void removeEOL(char * iBuffer)
+    {
+      if (iBuffer == NULL)
+        return;
+
+      int index = 0;
+      while(iBuffer[index] != '\0')
+      {
+        if (iBuffer[index] == '\n' && iBuffer[index+1] == '\r' && iBuffer[index+2] == '\0') //Windows
+          iBuffer[index] = '\0';
+        else if (iBuffer[index] == '\r' && iBuffer[index+1] == '\n' && iBuffer[index+2] == '\0') //Windows
+          iBuffer[index] = '\0';
+        else if (iBuffer[index] == '\n' && iBuffer[index+1] == '\0') // UNIX
+          iBuffer[index] = '\0';
+        else if (iBuffer[index] == '\r' && iBuffer[index+1] == '\0') // OLD MAC
+          iBuffer[index] = '\0';
+
+        index++;
+      }
+    }
+
+    StringVector splitString(const std::string & iText, char iSplitCharacter)
+    {
+      char pattern[] = {iSplitCharacter, '\0'};
+      StringVector list;
+      splitString(list, iText, pattern);
+      return list;
+    }
+
+    StringVector splitString(const std::string & iText, const char * iSplitPattern)
+    {
+      StringVector list;
+      splitString(list, iText, iSplitPattern);
+      return list;
+    }
+
+    void splitString(StringVector & oList, const std::string & iText, char iSplitCharacter)
+    {
+      char pattern[] = {iSplitCharacter, '\0'};
+      splitString(oList, iText, pattern);
+    }
+
+    void splitString(StringVector & oList, const std::string & iText, const char * iSplitPattern)
+    {
+      oList.clear();
+
+      StringTokenizer tokenizer(iText, iSplitPattern);
+      StringRef token;
+      while(tokenizer.next(token))
+      {
+        oList.push_back(std::string(token.data(), token.size()));
+      }
+    }
+
+    void splitString(StringRefVector & oList, const StringRef & iText, const char * iSplitPattern)
+    {
+      oList.clear();
+
+      StringTokenizer tokenizer(iText, iSplitPattern);
+      StringRef token;
+      while(tokenizer.next(token))
+      {
+        oList.push_back(token);
+      }
+    }
+
+    void splitString(StringList & oList, const StringRef & iText, const char * iSplitPattern)
+    {
+      oList.clear();
+
+      StringTokenizer tokenizer(iText, iSplitPattern);
+      StringRef token;
+      while(tokenizer.next(token))
+      {
+        oList.push_back(token);
+      }
+    }
+
+    //Minimum number of characters processed by each thread of splitStringParallel().
+    static const size_t PARALLEL_SPLIT_MIN_CHUNK_SIZE = 64 * 1024;
+
+    //Returns true if two occurrences of iPattern can overlap. That is, a proper prefix of iPattern is also a suffix.
+    inline bool hasSelfOverlap(const StringRef & iPattern)
+    {
+      for(size_t length = 1; length < iPattern.size(); length++)
+      {
+        if (memcmp(iPattern.data(), iPattern.end() - length, length) == 0)
+          return true;
+      }
+      return false;
+    }
+
+    //A partition of the text processed by splitStringParallel(). A partition always ends right after a separator, except for the last one.
+    struct SPLIT_CHUNK
+    {
+      SPLIT_CHUNK() :
+        first(NULL), last(NULL), pattern(NULL), patternSize(0), isLastChunk(false),
+        foundSeparator(false), isFirstTokenEmpty(false), isLastTokenEmpty(false),
+        strings(NULL), offset(0)
+      {}
+
+      const char * first;
+      const char * last;
+      const char * pattern;
+      size_t patternSize;
+      bool isLastChunk;
+
+      //results
+      StringRefVector tokens; //non-empty tokens
+      bool foundSeparator;
+      bool isFirstTokenEmpty;
+      bool isLastTokenEmpty;
+
+      //conversion to StringVector
+      StringVector * strings;
+      size_t offset;
+    };
+
+    void splitChunk(void * iChunk)
+    {
+      SPLIT_CHUNK & chunk = *(SPLIT_CHUNK *)iChunk;
+      const StringRef pattern(chunk.pattern, chunk.patternSize);
+      const char * position = chunk.first;
+      const char * separator = findPattern(position, chunk.last, pattern);
+      chunk.foundSeparator = (separator != NULL);
+      chunk.isFirstTokenEmpty = (separator == position);
+      while(separator != NULL)
+      {
+        if (separator != position)
+          chunk.tokens.push_back(StringRef(position, separator - position));
+        position = separator + pattern.size();
+        separator = findPattern(position, chunk.last, pattern);
+      }
+
+      //the characters after the last separator belongs to the next chunk unless this is the last chunk
+      if (chunk.isLastChunk)
+      {
+        chunk.isLastTokenEmpty = (position == chunk.last);
+        if (position != chunk.last)
+          chunk.tokens.push_back(StringRef(position, chunk.last - position));
+      }
+    }
+
+    void copyChunkTokens(void * iChunk)
+    {
+      SPLIT_CHUNK & chunk = *(SPLIT_CHUNK *)iChunk;
+      for(size_t i=0; i<chunk.tokens.size(); i++)
+      {
+        const StringRef & token = chunk.tokens[i];
+        (*chunk.strings)[chunk.offset + i].assign(token.data(), token.size());
+      }
+    }
+
+    //Splits iText into oChunks concurrently. Returns false if the text must be split on the calling thread.
+    bool splitChunks(std::vector<SPLIT_CHUNK> & oChunks, const StringRef & iText, const char * iSplitPattern, size_t iNumThreads)
+    {
+      const StringRef pattern(iSplitPattern);
+      if (pattern.empty() || hasSelfOverlap(pattern))
+        return false;
+
+      if (iNumThreads == 0)
+        iNumThreads = ra::parallel::getNumProcessors();
+      size_t numChunks = iText.size() / PARALLEL_SPLIT_MIN_CHUNK_SIZE;
+      if (numChunks > iNumThreads)
+        numChunks = iNumThreads;
+      if (numChunks <= 1)
+        return false;
+
+      //partition the text right after the first separator following each target position.
+      //Since occurrences of the pattern cannot overlap, they are the same as found by a serial scan.
+      oChunks.clear();
+      oChunks.reserve(numChunks);
+      const char * first = iText.begin();
+      for(size_t i=1; i<numChunks && first != iText.end(); i++)
+      {
+        const char * target = iText.begin() + (iText.size() / numChunks) * i;
+        if (target < first)
+          target = first;
+        const char * separator = findPattern(target, iText.end(), pattern);
+        if (separator == NULL)
+          break;
+        SPLIT_CHUNK chunk;
+        chunk.first = first;
+        chunk.last = separator + pattern.size();
+        chunk.pattern = pattern.data();
+        chunk.patternSize = pattern.size();
+        oChunks.push_back(chunk);
+        first = chunk.last;
+      }
+      SPLIT_CHUNK lastChunk;
+      lastChunk.first = first;
+      lastChunk.last = iText.end();
+      lastChunk.pattern = pattern.data();
+      lastChunk.patternSize = pattern.size();
+      lastChunk.isLastChunk = true;
+      oChunks.push_back(lastChunk);
+
+      std::vector<void *> tasks(oChunks.size());
+      for(size_t i=0; i<oChunks.size(); i++)
+      {
+        tasks[i] = &oChunks[i];
+      }
+      ra::parallel::runTasks(&splitChunk, &tasks[0], tasks.size());
+      return true;
+    }
+
+    //Computes the position of each chunk's tokens in the output list. Returns the total number of tokens.
+    //Like splitString(), an empty first or last token is only returned when the text contains a separator.
+    size_t getChunkOffsets(std::vector<SPLIT_CHUNK> & ioChunks, bool & oFirstEmpty, bool & oLastEmpty)
+    {
+      bool foundSeparator = false;
+      for(size_t i=0; i<ioChunks.size(); i++)
+        foundSeparator = foundSeparator || ioChunks[i].foundSeparator;
+      oFirstEmpty = foundSeparator && ioChunks.front().isFirstTokenEmpty;
+      oLastEmpty = foundSeparator && ioChunks.back().isLastTokenEmpty;
+
+      size_t count = (oFirstEmpty ? 1 : 0);
+      for(size_t i=0; i<ioChunks.size(); i++)
+      {
+        ioChunks[i].offset = count;
+        count += ioChunks[i].tokens.size();
+      }
+      count += (oLastEmpty ? 1 : 0);
+      return count;
+    }
+
+    void splitStringParallel(StringRefVector & oList, const StringRef & iText, const char * iSplitPattern, size_t iNumThreads)
+    {
+      std::vector<SPLIT_CHUNK> chunks;
+      if (!splitChunks(chunks, iText, iSplitPattern, iNumThreads))
+      {
+        splitString(oList, iText, iSplitPattern);
+        return;
+      }
+
+      bool firstEmpty = false;
+      bool lastEmpty = false;
+      size_t count = getChunkOffsets(chunks, firstEmpty, lastEmpty);
+
+      oList.clear();
+      oList.reserve(count);
+      if (firstEmpty)
+        oList.push_back(StringRef(iText.begin(), 0));
+      for(size_t i=0; i<chunks.size(); i++)
+        oList.insert(oList.end(), chunks[i].tokens.begin(), chunks[i].tokens.end());
+      if (lastEmpty)
+        oList.push_back(StringRef(iText.end(), 0));
+    }
+
+    void splitStringParallel(StringVector & oList, const StringRef & iText, const char * iSplitPattern, size_t iNumThreads)
+    {
+      std::vector<SPLIT_CHUNK> chunks;
+      if (!splitChunks(chunks, iText, iSplitPattern, iNumThreads))
+      {
+        oList.clear();
+        StringTokenizer tokenizer(iText, iSplitPattern);
+        StringRef token;
+        while(tokenizer.next(token))
+        {
+          oList.push_back(std::string(token.data(), token.size()));
+        }
+        return;
+      }
+
+      bool firstEmpty = false;
+      bool lastEmpty = false;
+      size_t count = getChunkOffsets(chunks, firstEmpty, lastEmpty);
+
+      //copy the tokens of each chunk concurrently. Empty first and last tokens are already empty strings.
+      oList.clear();
+      oList.resize(count);
+      std::vector<void *> tasks(chunks.size());
+      for(size_t i=0; i<chunks.size(); i++)
+      {
+        chunks[i].strings = &oList;
+        tasks[i] = &chunks[i];
+      }
+      ra::parallel::runTasks(&copyChunkTokens, &tasks[0], tasks.size());
+    }
+
+    StringTokenizer::StringTokenizer(const StringRef & iText, const StringRef & iSplitPattern) :
+      mText(iText),
+      mPattern(iSplitPattern)
+    {
+      reset();
+    }
+
+    void StringTokenizer::reset()
+    {
+      mPosition = 0;
+      mFoundSeparator = false;
+      mFinished = false;
+    }
+
+    bool StringTokenizer::next(StringRef & oToken)
+    {
+      //an empty pattern returns the whole text as a single token
+      if (mPattern.empty())
+      {
+        if (mFinished)
+          return false;
+        oToken = mText;
+        mFinished = true;
+        return true;
+      }
+
+      //empty tokens are skipped unless the text starts or ends with a separator
+      while(!mFinished)
+      {
+        const char * first = mText.data() + mPosition;
+        const char * separator = findPattern(first, mText.end(), mPattern);
+        if (separator != NULL)
+        {
+          bool isFirstToken = (mPosition == 0);
+          oToken = StringRef(first, separator - first);
+          mPosition = (separator - mText.data()) + mPattern.size();
+          mFoundSeparator = true;
+          if (!oToken.empty() || isFirstToken)
+            return true;
+        }
+        else
+        {
+          oToken = StringRef(first, mText.size() - mPosition);
+          mPosition = mText.size();
+          mFinished = true;
+          if (!oToken.empty() || mFoundSeparator)
+            return true;
+        }
+      }
+      return false;
+    }
+
+    //Orders StringList entries without moving the referenced characters.
+    struct StringListEntryLess
+    {
+      const char * mBuffer;
+      inline bool operator()(const StringList::ENTRY & a, const StringList::ENTRY & b) const
+      {
+        size_t length = (a.length < b.length ? a.length : b.length);
+        int result = memcmp(mBuffer + a.offset, mBuffer + b.offset, length);
+        if (result != 0)
+          return result < 0;
+        return a.length < b.length;
+      }
+    };
+
+    StringList::StringList()
+    {
+    }
+
+    StringList::StringList(const StringVector & iValues)
+    {
+      assign(iValues);
+    }
+
+    void StringList::clear()
+    {
+      mBuffer.clear();
+      mEntries.clear();
+    }
+
+    void StringList::reserve(size_t iCount, size_t iCharacters)
+    {
+      mEntries.reserve(iCount);
+      mBuffer.reserve(iCharacters + iCount); //each element is NULL terminated
+    }
+
+    void StringList::push_back(const StringRef & iValue)
+    {
+      //the value may reference the characters of this list which are moved when the buffer grows
+      const char * source = iValue.data();
+      const bool isInternal = (!mBuffer.empty() && source >= &mBuffer[0] && source < &mBuffer[0] + mBuffer.size());
+      const size_t sourceOffset = (isInternal ? source - &mBuffer[0] : 0);
+
+      ENTRY entry;
+      entry.offset = mBuffer.size();
+      entry.length = iValue.size();
+      mBuffer.resize(entry.offset + entry.length + 1);
+      if (isInternal)
+        source = &mBuffer[sourceOffset];
+      if (entry.length > 0)
+        memcpy(&mBuffer[entry.offset], source, entry.length);
+      mBuffer[entry.offset + entry.length] = '\0';
+      mEntries.push_back(entry);
+    }
+
+    void StringList::pop_back()
+    {
+      if (mEntries.empty())
+        return;
+      //after a sort(), the last entry is not necessarily at the end of the buffer
+      const ENTRY & entry = mEntries.back();
+      if (entry.offset + entry.length + 1 == mBuffer.size())
+        mBuffer.resize(entry.offset);
+      mEntries.pop_back();
+    }
+
+    void StringList::sort()
+    {
+      if (mEntries.empty())
+        return;
+      StringListEntryLess less = { &mBuffer[0] };
+      std::sort(mEntries.begin(), mEntries.end(), less);
+    }
+
+    void StringList::assign(const StringVector & iValues)
+    {
+      clear();
+
+      size_t numCharacters = 0;
+      for(size_t i=0; i<iValues.size(); i++)
+      {
+        numCharacters += iValues[i].size();
+      }
+      reserve(iValues.size(), numCharacters);
+
+      for(size_t i=0; i<iValues.size(); i++)
+      {
+        push_back(iValues[i]);
+      }
+    }
+
+    void StringList::toStringVector(StringVector & oValues) const
+    {
+      oValues.clear();
+      oValues.reserve(mEntries.size());
+      for(size_t i=0; i<mEntries.size(); i++)
+      {
+        const StringRef value = (*this)[i];
+        oValues.push_back(std::string(value.data(), value.size()));
+      }
+    }
+
+    void StringList::swap(StringList & ioOther)
+    {
+      mBuffer.swap(ioOther.mBuffer);
+      mEntries.swap(ioOther.mEntries);
+    }
+
+    //Returns a pointer to the first LF or CR character in [iFirst, iLast). Returns iLast if not found.
+    inline const char * findNewLine(const char * iFirst, const char * iLast)
+    {
+#ifdef RA_STRINGS_SSE2
+      const __m128i lf = _mm_set1_epi8('\n');
+      const __m128i cr = _mm_set1_epi8('\r');
+      while(iLast - iFirst >= 16)
+      {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)iFirst);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+        if (mask != 0)
+        {
+          //find first new line character
+          for(int j=0; j<16; j++)
+          {
+            if ((mask & (1 << j)) != 0)
+              return iFirst + j;
+          }
+        }
+        iFirst += 16;
+      }
+#endif
+      while(iFirst != iLast && *iFirst != '\n' && *iFirst != '\r')
+        iFirst++;
+      return iFirst;
+    }
+
+    LineTokenizer::LineTokenizer(const StringRef & iText) :
+      mText(iText)
+    {
+      reset();
+    }
+
+    void LineTokenizer::reset()
+    {
+      mPosition = 0;
+      mLineNumber = 0;
+    }
+
+    bool LineTokenizer::next(StringRef & oLine)
+    {
+      if (mPosition >= mText.size())
+        return false;
+
+      const char * first = mText.data() + mPosition;
+      const char * last = mText.end();
+      const char * terminator = findNewLine(first, last);
+      oLine = StringRef(first, terminator - first);
+
+      //skip the terminator. CRLF counts as a single terminator.
+      if (terminator != last)
+      {
+        if (*terminator == '\r' && terminator + 1 != last && terminator[1] == '\n')
+          terminator += 2;
+        else
+          terminator++;
+      }
+      mPosition = terminator - mText.data();
+      mLineNumber++;
+      return true;
+    }
+
+    std::string joinString(const StringVector & iList, const char * iSeparator)
+    {
+      return joinString(iList.begin(), iList.end(), iSeparator);
+    }
+
+    std::string joinString(const StringList & iList, const char * iSeparator)
+    {
+      return joinString(iList.begin(), iList.end(), iSeparator);
+    }
+
+    //Set of characters for fast membership tests.
+    class CharacterSet
+    {
+    public:
+      CharacterSet(const char * iCharacters)
+      {
+        memset(mMembers, 0, sizeof(mMembers));
+        if (iCharacters == NULL)
+          return;
+        for(const unsigned char * c = (const unsigned char *)iCharacters; *c != '\0'; c++)
+          mMembers[*c] = true;
+      }
+      inline bool contains(char c) const { return mMembers[(unsigned char)c]; }
+    private:
+      bool mMembers[256];
+    };
+
+    //Predicates which defines characters to trim
+    struct IsCharacter
+    {
+      char mChar;
+      inline bool operator()(char c) const { return c == mChar; }
+    };
+    struct IsInSet
+    {
+      const CharacterSet * mSet;
+      inline bool operator()(char c) const { return mSet->contains(c); }
+    };
+
+    template <class Predicate>
+    inline StringRef trimLeftT(const StringRef & iStr, const Predicate & iPredicate)
+    {
+      const char * first = iStr.begin();
+      const char * last = iStr.end();
+      while(first != last && iPredicate(*first))
+        first++;
+      return StringRef(first, last - first);
+    }
+
+    template <class Predicate>
+    inline StringRef trimRightT(const StringRef & iStr, const Predicate & iPredicate)
+    {
+      const char * first = iStr.begin();
+      const char * last = iStr.end();
+      while(last != first && iPredicate(*(last-1)))
+        last--;
+      return StringRef(first, last - first);
+    }
+
+    //Shrinks ioStr to the given range within ioStr. The bounds are computed once and characters are moved at most once.
+    inline void assignRange(std::string & ioStr, const StringRef & iRange)
+    {
+      size_t offset = iRange.data() - ioStr.data();
+      if (offset == 0)
+        ioStr.resize(iRange.size());
+      else
+        ioStr.erase(0, offset).resize(iRange.size());
+    }
+
+    StringRef trimRef(const StringRef & iStr, const char iChar)
+    {
+      if (iChar == '\0')
+        return iStr;
+      IsCharacter predicate = { iChar };
+      return trimLeftT(trimRightT(iStr, predicate), predicate);
+    }
+
+    StringRef trimRightRef(const StringRef & iStr, const char iChar)
+    {
+      if (iChar == '\0')
+        return iStr;
+      IsCharacter predicate = { iChar };
+      return trimRightT(iStr, predicate);
+    }
+
+    StringRef trimLeftRef(const StringRef & iStr, const char iChar)
+    {
+      if (iChar == '\0')
+        return iStr;
+      IsCharacter predicate = { iChar };
+      return trimLeftT(iStr, predicate);
+    }
+
+    StringRef trimRef(const StringRef & iStr, const char * iCharacters)
+    {
+      CharacterSet set(iCharacters);
+      IsInSet predicate = { &set };
+      return trimLeftT(trimRightT(iStr, predicate), predicate);
+    }
+
+    StringRef trimRightRef(const StringRef & iStr, const char * iCharacters)
+    {
+      CharacterSet set(iCharacters);
+      IsInSet predicate = { &set };
+      return trimRightT(iStr, predicate);
+    }
+
+    StringRef trimLeftRef(const StringRef & iStr, const char * iCharacters)
+    {
+      CharacterSet set(iCharacters);
+      IsInSet predicate = { &set };
+      return trimLeftT(iStr, predicate);
+    }
+
+    void trimInPlace(std::string & ioStr, const char iChar)
+    {
+      assignRange(ioStr, trimRef(ioStr, iChar));
+    }
+
+    void trimRightInPlace(std::string & ioStr, const char iChar)
+    {
+      assignRange(ioStr, trimRightRef(ioStr, iChar));
+    }
+
+    void trimLeftInPlace(std::string & ioStr, const char iChar)
+    {
+      assignRange(ioStr, trimLeftRef(ioStr, iChar));
+    }
+
+    void trimInPlace(std::string & ioStr, const char * iCharacters)
+    {
+      assignRange(ioStr, trimRef(ioStr, iCharacters));
+    }
+
+    void trimRightInPlace(std::string & ioStr, const char * iCharacters)
+    {
+      assignRange(ioStr, trimRightRef(ioStr, iCharacters));
+    }
+
+    void trimLeftInPlace(std::string & ioStr, const char * iCharacters)
+    {
+      assignRange(ioStr, trimLeftRef(ioStr, iCharacters));
+    }
+
+    std::string trim(const std::string & iStr)
+    {
+      return trim(iStr, ' ');
+    }
+
+    std::string trim(const std::string & iStr, const char iChar)
+    {
+      return trimRef(iStr, iChar).toString();
+    }
+
+    std::string trimRight(const std::string & iStr)
+    {
+      return trimRight(iStr, ' ');
+    }
+
+    std::string trimLeft(const std::string & iStr)
+    {
+      return trimLeft(iStr, ' ');
+    }
+
+    std::string trimRight(const std::string & iStr, const char iChar)
+    {
+      return trimRightRef(iStr, iChar).toString();
+    }
+
+    std::string trimLeft(const std::string & iStr, const char iChar)
+    {
+      return trimLeftRef(iStr, iChar).toString();
+    }
+
+    std::string reverse(const std::string & iStr)
+    {
+      std::string tmp = iStr;
+
+      size_t size = iStr.size();
+      if (size)
+      {
+        size_t loopStart = 0;
+        size_t loopEnd = (size - 1) / 2;
+        for(size_t i = loopStart; i <= loopEnd; i++)
+        {
+          if (i != (size - i - 1))
+          {
+            ra::generics::swap(tmp[i], tmp[size - i - 1]);
+          }
+        }
+      }
+      return tmp;
+    }
+
+    std::string format(const char * iFormat, ...)
+    {
+      std::string output;
+
+      va_list args;
+      va_start(args, iFormat);
+      vappendFormat(output, iFormat, args);
+      va_end (args);
+
+      return output;
+    }
+
+    std::string vformat(const char * iFormat, va_list iArgs)
+    {
+      std::string output;
+      vappendFormat(output, iFormat, iArgs);
+      return output;
+    }
+
+    void appendFormat(std::string & ioString, const char * iFormat, ...)
+    {
+      va_list args;
+      va_start(args, iFormat);
+      vappendFormat(ioString, iFormat, args);
+      va_end (args);
+    }
+
+    void vappendFormat(std::string & ioString, const char * iFormat, va_list iArgs)
+    {
+      if (iFormat == NULL)
+        return;
+
+      //measure the formatted length
+      va_list args;
+      va_copy(args, iArgs);
+      int length = vsnprintf(NULL, 0, iFormat, args);
+      va_end(args);
+      if (length <= 0)
+        return;
+
+      //write in place. The terminating NULL character is written in the string's own terminator.
+      size_t offset = ioString.size();
+      ioString.resize(offset + (size_t)length);
+      vsnprintf(&ioString[offset], (size_t)length + 1, iFormat, iArgs);
+    }
+
+    StringBuilder::StringBuilder() :
+      mData(mInline),
+      mSize(0),
+      mCapacity(INLINE_CAPACITY)
+    {
+      mInline[0] = '\0';
+    }
+
+    StringBuilder::StringBuilder(size_t iCapacity) :
+      mData(mInline),
+      mSize(0),
+      mCapacity(INLINE_CAPACITY)
+    {
+      mInline[0] = '\0';
+      reserve(iCapacity);
+    }
+
+    StringBuilder::StringBuilder(const StringBuilder & iOther) :
+      mData(mInline),
+      mSize(0),
+      mCapacity(INLINE_CAPACITY)
+    {
+      mInline[0] = '\0';
+      append(iOther.data(), iOther.size());
+    }
+
+    StringBuilder & StringBuilder::operator=(const StringBuilder & iOther)
     {
-      static const T ZERO = (T)0;
-      static const T MULTIPLIER = (T)10;
-      static const T SIGN_MULTIPLIER = (T)-1;
-      bool parseOK = false;
-      t = ZERO;
-      for(size_t i=0; i<str.size(); i++)
+      if (this != &iOther)
       {
-        char c = str[i];
-        if (c >= '0' && c <= '9')
-        {
-          t *= MULTIPLIER;
-          c -= '0'; //convert character to numeric value
-          t += (T)c;
-          parseOK = true;
-        }
-        else if (c == '-')
-        {
-          t *= SIGN_MULTIPLIER;
-          parseOK = true;
-        }
+        clear();
+        append(iOther.data(), iOther.size());
       }
-      return parseOK;
+      return (*this);
     }
 
-    //Note: http://www.parashift.com/c++-faq-lite/misc-technical-issues.html#faq-39.2
-    template <class T>
-    inline std::string toStringT (const T & t)
+    void StringBuilder::reserve(size_t iCapacity)
     {
-      std::stringstream out;
-      out << t;
-      std::string s;
-      s = out.str().c_str();
-      return s;
+      if (iCapacity + 1 > mCapacity)
+      {
+        grow(iCapacity - mSize);
+      }
     }
 
-    //template <class T>
-    //inline void toT (const char * iValue, T & t)
-    //{
-    //  std::string tmpString = iValue;
-    //  std::istringstream inputStream(tmpString);
-    //  inputStream >> t;
-    //}
-
-    //specializations
-    template<>
-    inline std::string toStringT<unsigned char>(const unsigned char & t)
+    void StringBuilder::clear()
     {
-      std::stringstream out;
-      out << (int)t;
-      std::string s;
-      s = out.str();
-      return s;
+      mSize = 0;
+      mData[0] = '\0';
     }
-    template<>
-    inline std::string toStringT<char>(const char & t)
+
+    void StringBuilder::release(std::string & oString)
     {
-      std::stringstream out;
-      out << (int)t;
-      std::string s;
-      s = out.str();
-      return s;
+      if (mData == mInline)
+      {
+        oString.assign(mData, mSize);
+      }
+      else
+      {
+        //shrinking a std::string never reallocates
+        mHeap.resize(mSize);
+        oString.swap(mHeap);
+        mHeap = std::string();
+        mData = mInline;
+        mCapacity = INLINE_CAPACITY;
+      }
+      clear();
     }
 
-    //template<>
-    //inline void toT<unsigned char>(const char * iValue, unsigned char & t)
-    //{
-    //  std::string tmpString = iValue;
-    //  std::istringstream inputStream(tmpString);
-    //  uint16 tmp = 0;
-    //  inputStream >> tmp;
-    //  t = (unsigned char)tmp;
-    //}
-    //template<>
-    //inline void toT<char>(const char * iValue, char & t)
-    //{
-    //  std::string tmpString = iValue;
-    //  std::istringstream inputStream(tmpString);
-    //  sint16 tmp = 0;
-    //  inputStream >> tmp;
-    //  t = (char)tmp;
-    //}
-
-    bool isNumeric(const char * iValue)
+    char * StringBuilder::grow(size_t iSize)
     {
-      if (iValue == NULL)
-        return false;
-
-      bool foundDot = false;
-      size_t length = strlen(iValue);
-      for(size_t offset = 0; offset < length; offset++)
+      size_t required = mSize + iSize + 1;
+      if (required > mCapacity)
       {
-        const char & c = iValue[offset];
-        if (c >= '0' && c <= '9')
-          continue; //valid
-        if (c == '.' && !foundDot)
+        //geometric growth
+        size_t newCapacity = mCapacity * 2;
+        if (newCapacity < required)
+          newCapacity = required;
+
+        if (mData == mInline)
         {
-          //only 1 dot character must be found in the string
-          foundDot = true;
-          continue; //valid
+          mHeap.resize(newCapacity);
+          memcpy(&mHeap[0], mInline, mSize + 1);
         }
-        if ((c == '+' || c == '-'))
+        else
         {
-          if (offset == 0)
-          {
-            //+ or - sign are accepted but must be the first character of the value
-            continue; //valid
-          }
+          mHeap.resize(newCapacity);
         }
-
-        return false; //invalid
+        mData = &mHeap[0];
+        mCapacity = newCapacity;
       }
-      return true;
+      return mData + mSize;
     }
 
-    int strReplace(std::string & iString, const char * iOldValue, const char * iNewValue)
+    StringBuilder & StringBuilder::append(const char * iValue, size_t iSize)
     {
-      std::string tmpOldValue = iOldValue;
-      std::string tmpNewValue = iNewValue;
+      if (iSize == 0)
+        return (*this);
+
+      //the value may reference the characters of this builder which are moved when the buffer grows
+      const bool isInternal = (iValue >= mData && iValue <= mData + mSize);
+      const size_t sourceOffset = (isInternal ? iValue - mData : 0);
+
+      char * position = grow(iSize);
+      if (isInternal)
+        iValue = mData + sourceOffset;
+      memcpy(position, iValue, iSize);
+      mSize += iSize;
+      mData[mSize] = '\0';
+      return (*this);
+    }
 
-      int numOccurance = 0;
+    StringBuilder & StringBuilder::append(const char * iValue)
+    {
+      if (iValue == NULL)
+        return (*this);
+      return append(iValue, strlen(iValue));
+    }
 
-      if (tmpOldValue.size() > 0)
-      {
-        size_t startPos = 0;    
-        size_t findPos = std::string::npos;
-        do
-        {
-          findPos = iString.find(tmpOldValue, startPos);
-          if (findPos != std::string::npos)
-          {
-            iString.replace(findPos, tmpOldValue.length(), tmpNewValue);
-            startPos = findPos + tmpNewValue.length();
-            numOccurance++;
-          }
-        }
-        while (findPos != -1);
-      }
-      return numOccurance;
+    StringBuilder & StringBuilder::append(const std::string & iValue)
+    {
+      return append(iValue.data(), iValue.size());
     }
 
-    std::string toString(const uint64_t & value)
+    StringBuilder & StringBuilder::append(const StringRef & iValue)
     {
-      return toStringT(value);
+      return append(iValue.data(), iValue.size());
     }
 
-    bool parseValue(const std::string& str, uint64_t & oValue)
+    StringBuilder & StringBuilder::append(const char & iValue)
     {
-      return parseValueT(str, oValue);
+      //copy the value before growing, it may reference a character of this builder
+      const char value = iValue;
+      char * position = grow(1);
+      position[0] = value;
+      position[1] = '\0';
+      mSize++;
+      return (*this);
     }
 
-    std::string capitalizeFirstCharacter(const std::string & iValue)
+    StringBuilder & StringBuilder::append(const void * iValue)
     {
-      std::string copy = iValue;
-      if (!copy.empty())
+      //same format as operator<<(std::string&, const void *): 0x followed by all hexadecimal digits of the address
+      static const char * hexCharacters = "0123456789ABCDEF";
+      static const size_t NUM_DIGITS = sizeof(void*)*2;
+      size_t address = reinterpret_cast<size_t>(iValue);
+      char * position = grow(2 + NUM_DIGITS);
+      position[0] = '0';
+      position[1] = 'x';
+      for(size_t i=0; i<NUM_DIGITS; i++)
       {
-        copy[0] = (char)toupper(copy[0]);
+        position[2 + NUM_DIGITS - 1 - i] = hexCharacters[address & 0xF];
+        address >>= 4;
       }
-      return copy;
+      mSize += 2 + NUM_DIGITS;
+      mData[mSize] = '\0';
+      return (*this);
     }
 
-    std::string uppercase(const std::string & iValue)
+    template <class T>
+    inline StringBuilder & StringBuilder::appendNumericT(const T & iValue)
     {
-      std::string copy = iValue;
-      for(size_t i=0; i<copy.size(); i++)
-      {
-        copy[i] = (char)toupper(copy[i]);
-      }
-      return copy;
+      //toChars() writes the value and the NULL terminating character directly in the buffer
+      char * position = grow(TOCHARS_BUFFER_SIZE);
+      mSize += toChars(position, iValue);
+      return (*this);
     }
 
-    std::string lowercase(const std::string & iValue)
+    StringBuilder & StringBuilder::append(const int8_t & iValue)
     {
-      std::string copy = iValue;
-      for(size_t i=0; i<copy.size(); i++)
-      {
-        copy[i] = (char)tolower(copy[i]);
-      }
-      return copy;
+      return appendNumericT(iValue);
     }
 
-    void removeEOL(char * iBuffer)
+    StringBuilder & StringBuilder::append(const uint8_t & iValue)
     {
-      if (iBuffer == NULL)
-        return;
+      return appendNumericT(iValue);
+    }
 
-      int index = 0;
-      while(iBuffer[index] != '\0')
-      {
-        if (iBuffer[index] == '\n' && iBuffer[index+1] == '\r' && iBuffer[index+2] == '\0') //Windows
-          iBuffer[index] = '\0';
-        else if (iBuffer[index] == '\r' && iBuffer[index+1] == '\n' && iBuffer[index+2] == '\0') //Windows
-          iBuffer[index] = '\0';
-        else if (iBuffer[index] == '\n' && iBuffer[index+1] == '\0') // UNIX
-          iBuffer[index] = '\0';
-        else if (iBuffer[index] == '\r' && iBuffer[index+1] == '\0') // OLD MAC
-          iBuffer[index] = '\0';
+    StringBuilder & StringBuilder::append(const int16_t & iValue)
+    {
+      return appendNumericT(iValue);
+    }
 
-        index++;
-      }
+    StringBuilder & StringBuilder::append(const uint16_t & iValue)
+    {
+      return appendNumericT(iValue);
     }
 
-    StringVector splitString(const std::string & iText, char iSplitCharacter)
+    StringBuilder & StringBuilder::append(const int32_t & iValue)
     {
-      char pattern[] = {iSplitCharacter, '\0'};
-      StringVector list;
-      splitString(list, iText, pattern);
-      return list;
+      return appendNumericT(iValue);
     }
 
-    StringVector splitString(const std::string & iText, const char * iSplitPattern)
+    StringBuilder & StringBuilder::append(const uint32_t & iValue)
     {
-      StringVector list;
-      splitString(list, iText, iSplitPattern);
-      return list;
+      return appendNumericT(iValue);
     }
 
-    void splitString(StringVector & oList, const std::string & iText, char iSplitCharacter)
+    StringBuilder & StringBuilder::append(const int64_t & iValue)
     {
-      char pattern[] = {iSplitCharacter, '\0'};
-      splitString(oList, iText, pattern);
+      return appendNumericT(iValue);
     }
 
-    void splitString(StringVector & oList, const std::string & iText, const char * iSplitPattern)
+    StringBuilder & StringBuilder::append(const uint64_t & iValue)
     {
-      oList.clear();
+      return appendNumericT(iValue);
+    }
+
+    StringBuilder & StringBuilder::append(const float & iValue)
+    {
+      return appendNumericT(iValue);
+    }
+
+    StringBuilder & StringBuilder::append(const double & iValue)
+    {
+      return appendNumericT(iValue);
+    }
 
-      //validate invalue split pattern
-      if (iSplitPattern == NULL || strlen(iSplitPattern) == 0)
+    GlobMatcher::GlobMatcher()
+    {
+      compile(StringRef());
+    }
+
+    GlobMatcher::GlobMatcher(const StringRef & iPattern)
+    {
+      compile(iPattern);
+    }
+
+    void GlobMatcher::compile(const StringRef & iPattern)
+    {
+      mCharacters.clear();
+      mSegments.clear();
+      mPatterns.clear();
+      mHasPositivePatterns = true;
+      addPattern(iPattern, false);
+    }
+
+    void GlobMatcher::compileFilter(const StringRef & iFilter)
+    {
+      mCharacters.clear();
+      mSegments.clear();
+      mPatterns.clear();
+      mHasPositivePatterns = false;
+
+      //the first '-' character starts the negative patterns
+      const char * separator = (iFilter.empty() ? NULL : (const char *)memchr(iFilter.data(), '-', iFilter.size()));
+      const StringRef positives(iFilter.data(), (separator == NULL ? iFilter.size() : separator - iFilter.data()));
+      const StringRef negatives = (separator == NULL ? StringRef() : StringRef(separator + 1, iFilter.end() - separator - 1));
+
+      StringRef pattern;
+      StringTokenizer positiveTokenizer(positives, ":");
+      while(positiveTokenizer.next(pattern))
       {
-        oList.push_back(iText);
-        return;
+        if (!pattern.empty())
+        {
+          addPattern(pattern, false);
+          mHasPositivePatterns = true;
+        }
+      }
+      StringTokenizer negativeTokenizer(negatives, ":");
+      while(negativeTokenizer.next(pattern))
+      {
+        if (!pattern.empty())
+          addPattern(pattern, true);
       }
+    }
 
-      std::string accumulator;
-      std::string pattern = iSplitPattern;
-      for(size_t i=0; i<iText.size(); i++)
+    void GlobMatcher::addPattern(const StringRef & iPattern, bool iNegative)
+    {
+      PATTERN pattern;
+      pattern.firstSegment = mSegments.size();
+      pattern.numSegments = 0;
+      pattern.anchoredStart = (iPattern.empty() || iPattern[0] != '*');
+      pattern.anchoredEnd = (iPattern.empty() || iPattern[iPattern.size()-1] != '*');
+      pattern.negative = iNegative;
+
+      //split the pattern on '*' characters. Consecutive '*' characters are merged.
+      const char * first = iPattern.begin();
+      const char * last = iPattern.end();
+      while(first != last)
       {
-        const char * substring = &iText[i];
-        if (strncmp(substring, pattern.c_str(), pattern.size()) == 0)
+        const char * star = (const char *)memchr(first, '*', last - first);
+        const char * segmentEnd = (star == NULL ? last : star);
+        if (segmentEnd != first)
         {
-          //found a split pattern
-
-          //flush current accumulator
-          if (accumulator != "")
-          {
-            oList.push_back(accumulator);
-            accumulator = "";
-          }
-
-          //does iTest starts with a separator?
-          if (i == 0)
-          {
-            oList.push_back("");
-          }
-
-          i += pattern.size();
+          SEGMENT segment;
+          segment.offset = mCharacters.size();
+          segment.length = segmentEnd - first;
+          segment.hasWildcard = (memchr(first, '?', segment.length) != NULL);
+          mCharacters.append(first, segment.length);
+          mSegments.push_back(segment);
+          pattern.numSegments++;
+        }
+        first = (star == NULL ? last : star + 1);
+      }
 
-          //does iText ends with a separator?
-          if (iText[i] == '\0')
-          {
-            oList.push_back("");
-          }
+      mPatterns.push_back(pattern);
+    }
 
-          i--; //since the next loop will increase i by 1
+    bool GlobMatcher::match(const StringRef & iValue) const
+    {
+      bool matched = !mHasPositivePatterns;
+      for(size_t i=0; i<mPatterns.size(); i++)
+      {
+        const PATTERN & pattern = mPatterns[i];
+        if (pattern.negative)
+        {
+          if (matchPattern(pattern, iValue))
+            return false;
         }
-        else
+        else if (!matched)
         {
-          char tmp[] = { iText[i], '\0' };
-          accumulator.append(tmp);
+          matched = matchPattern(pattern, iValue);
         }
       }
+      return matched;
+    }
 
-      //flush current accumulator
-      if (accumulator != "")
+    bool GlobMatcher::matchSegment(const SEGMENT & iSegment, const char * iValue) const
+    {
+      const char * segment = mCharacters.data() + iSegment.offset;
+      if (!iSegment.hasWildcard)
+        return memcmp(segment, iValue, iSegment.length) == 0;
+      for(size_t i=0; i<iSegment.length; i++)
       {
-        oList.push_back(accumulator);
-        accumulator = "";
+        if (segment[i] != '?' && segment[i] != iValue[i])
+          return false;
       }
+      return true;
     }
 
-    std::string joinString(const StringVector & iList, const char * iSeparator)
+    const char * GlobMatcher::findSegment(const SEGMENT & iSegment, const char * iFirst, const char * iLast) const
     {
-      std::string output;
-      for(size_t i=0; i<iList.size(); i++)
+      if ((size_t)(iLast - iFirst) < iSegment.length)
+        return NULL;
+      if (!iSegment.hasWildcard)
+        return findPattern(iFirst, iLast, StringRef(mCharacters.data() + iSegment.offset, iSegment.length));
+
+      const char * lastCandidate = iLast - iSegment.length;
+      for(const char * candidate = iFirst; candidate <= lastCandidate; candidate++)
       {
-        const std::string & value = iList[i];
-        if (!output.empty() && iSeparator != NULL)
-          output.append(iSeparator);
-        output.append(value);
+        if (matchSegment(iSegment, candidate))
+          return candidate;
       }
-      return output;
+      return NULL;
     }
 
-    std::string trim(const std::string & iStr)
+    bool GlobMatcher::matchPattern(const PATTERN & iPattern, const StringRef & iValue) const
     {
-      return trimLeft(trimRight(iStr));
+      const char * first = iValue.begin();
+      const char * last = iValue.end();
+      size_t begin = iPattern.firstSegment;
+      size_t end = iPattern.firstSegment + iPattern.numSegments;
+
+      if (iPattern.numSegments == 0)
+        return (!iPattern.anchoredStart || first == last); //empty pattern or '*' only
+
+      //the first segment must match the beginning of the value
+      if (iPattern.anchoredStart)
+      {
+        const SEGMENT & segment = mSegments[begin];
+        if ((size_t)(last - first) < segment.length || !matchSegment(segment, first))
+          return false;
+        first += segment.length;
+        begin++;
+        if (begin == end)
+          return (!iPattern.anchoredEnd || first == last);
+      }
+
+      //the last segment must match the end of the value
+      if (iPattern.anchoredEnd)
+      {
+        const SEGMENT & segment = mSegments[end - 1];
+        if ((size_t)(last - first) < segment.length || !matchSegment(segment, last - segment.length))
+          return false;
+        last -= segment.length;
+        end--;
+      }
+
+      //the leftmost match of each remaining segment is always the best choice. No backtracking is required.
+      for(size_t i=begin; i<end; i++)
+      {
+        const SEGMENT & segment = mSegments[i];
+        const char * position = findSegment(segment, first, last);
+        if (position == NULL)
+          return false;
+        first = position + segment.length;
+      }
+      return true;
     }
 
-    std::string trim(const std::string & iStr, const char iChar)
+    bool globMatch(const StringRef & iPattern, const StringRef & iValue)
     {
-      return trimLeft(trimRight(iStr, iChar), iChar);
+      GlobMatcher matcher(iPattern);
+      return matcher.match(iValue);
     }
 
-    std::string trimRight(const std::string & iStr)
+    inline ra::parallel::Mutex & getMutex(void * iMutex)
     {
-      return trimRight(iStr, ' ');
+      return *(ra::parallel::Mutex *)iMutex;
     }
 
-    std::string trimLeft(const std::string & iStr)
+    const StringPool::ID StringPool::INVALID_ID;
+
+    static const size_t STRINGPOOL_BLOCK_SIZE = 64 * 1024;
+    static const size_t STRINGPOOL_MIN_BUCKETS = 64;
+
+    StringPool::StringPool() :
+      mBlock(NULL),
+      mBlockSize(0),
+      mMutex(new ra::parallel::Mutex())
     {
-      return trimLeft(iStr, ' ');
+      mBuckets.resize(STRINGPOOL_MIN_BUCKETS, INVALID_ID);
     }
 
-    std::string trimRight(const std::string & iStr, const char iChar)
+    StringPool::~StringPool()
     {
-      static const size_t SIZE_T_MAX = std::numeric_limits< size_t >::max();
-      
-      std::string tmp = iStr;
-
-      if (iChar == '\0')
-        return tmp;
+      release();
+      delete (ra::parallel::Mutex *)mMutex;
+    }
 
-      size_t size = iStr.size();
-      if (size)
+    void StringPool::release()
+    {
+      for(size_t i=0; i<mBlocks.size(); i++)
       {
-        size_t loopStart = size - 1;
-        size_t loopEnd = 0;
-        for(size_t i = loopStart; i >= loopEnd && i != SIZE_T_MAX; i--)
-        {
-          if (tmp[i] == iChar)
-          {
-            tmp.erase(i, 1);
-          }
-          else
-          {
-            //no need to continue looking
-            break;
-          }
-        }
+        delete[] mBlocks[i];
       }
-      return tmp;
+      mBlocks.clear();
+      mBlock = NULL;
+      mBlockSize = 0;
     }
 
-    std::string trimLeft(const std::string & iStr, const char iChar)
+    void StringPool::clear()
     {
-      std::string tmp = iStr;
+      ra::parallel::MutexLock lock(getMutex(mMutex));
+      release();
+      mEntries.clear();
+      mBuckets.assign(STRINGPOOL_MIN_BUCKETS, INVALID_ID);
+    }
 
-      if (iChar == '\0')
-        return tmp;
+    size_t StringPool::size() const
+    {
+      ra::parallel::MutexLock lock(getMutex(mMutex));
+      return mEntries.size();
+    }
 
-      size_t size = iStr.size();
-      if (size)
+    StringPool::ID StringPool::findLocked(const StringRef & iValue, uint64_t iHash, size_t & oBucket) const
+    {
+      const size_t mask = mBuckets.size() - 1;
+      size_t bucket = (size_t)iHash & mask;
+      while(mBuckets[bucket] != INVALID_ID)
       {
-        while(!tmp.empty() && tmp[0] == iChar)
+        const ENTRY & entry = mEntries[mBuckets[bucket]];
+        if (entry.hash == iHash && entry.size == iValue.size() && memcmp(entry.data, iValue.data(), entry.size) == 0)
         {
-          tmp.erase(0, 1);
+          oBucket = bucket;
+          return mBuckets[bucket];
         }
+        bucket = (bucket + 1) & mask;
       }
-      return tmp;
+      oBucket = bucket;
+      return INVALID_ID;
     }
 
-    std::string reverse(const std::string & iStr)
+    const char * StringPool::allocate(const StringRef & iValue)
     {
-      std::string tmp = iStr;
-
-      size_t size = iStr.size();
-      if (size)
+      const size_t size = iValue.size() + 1; //including NULL terminating character
+      char * destination = NULL;
+      if (size > STRINGPOOL_BLOCK_SIZE / 4)
       {
-        size_t loopStart = 0;
-        size_t loopEnd = (size - 1) / 2;
-        for(size_t i = loopStart; i <= loopEnd; i++)
+        //large strings gets their own block to keep the current block filled
+        destination = new char[size];
+        mBlocks.push_back(destination);
+      }
+      else
+      {
+        if (mBlock == NULL || mBlockSize + size > STRINGPOOL_BLOCK_SIZE)
         {
-          if (i != (size - i - 1))
-          {
-            ra::generics::swap(tmp[i], tmp[size - i - 1]);
-          }
+          mBlock = new char[STRINGPOOL_BLOCK_SIZE];
+          mBlockSize = 0;
+          mBlocks.push_back(mBlock);
         }
+        destination = mBlock + mBlockSize;
+        mBlockSize += size;
       }
-      return tmp;
+      if (!iValue.empty())
+        memcpy(destination, iValue.data(), iValue.size());
+      destination[iValue.size()] = '\0';
+      return destination;
     }
 
-    std::string format(const char * iFormat, ...)
+    void StringPool::rehash(size_t iBucketCount)
     {
-      std::string output;
+      mBuckets.assign(iBucketCount, INVALID_ID);
+      const size_t mask = iBucketCount - 1;
+      for(size_t id=0; id<mEntries.size(); id++)
+      {
+        size_t bucket = (size_t)mEntries[id].hash & mask;
+        while(mBuckets[bucket] != INVALID_ID)
+          bucket = (bucket + 1) & mask;
+        mBuckets[bucket] = (ID)id;
+      }
+    }
 
-      va_list args;
-      va_start(args, iFormat);
+    StringPool::ID StringPool::intern(const StringRef & iValue)
+    {
+      const uint64_t hash = ra::hash::hash64(iValue.data(), iValue.size());
+
+      ra::parallel::MutexLock lock(getMutex(mMutex));
+      size_t bucket = 0;
+      ID id = findLocked(iValue, hash, bucket);
+      if (id != INVALID_ID)
+        return id;
+      if (mEntries.size() >= (size_t)INVALID_ID)
+        return INVALID_ID; //pool is full
+
+      ENTRY entry;
+      entry.data = allocate(iValue);
+      entry.size = iValue.size();
+      entry.hash = hash;
+      id = (ID)mEntries.size();
+      mEntries.push_back(entry);
+      mBuckets[bucket] = id;
+
+      //keep the hash table at most half full
+      if (mEntries.size() * 2 > mBuckets.size())
+        rehash(mBuckets.size() * 2);
+
+      return id;
+    }
 
-      static const int BUFFER_SIZE = 10240;
-      char buffer[BUFFER_SIZE];
-      buffer[0] = '\0';
-      vsnprintf(buffer, BUFFER_SIZE, iFormat, args);
-      output = buffer;
+    StringPool::ID StringPool::find(const StringRef & iValue) const
+    {
+      const uint64_t hash = ra::hash::hash64(iValue.data(), iValue.size());
 
-      va_end (args);
+      ra::parallel::MutexLock lock(getMutex(mMutex));
+      size_t bucket = 0;
+      return findLocked(iValue, hash, bucket);
+    }
 
-      return output;
+    StringRef StringPool::get(ID iId) const
+    {
+      ra::parallel::MutexLock lock(getMutex(mMutex));
+      if (iId >= mEntries.size())
+        return StringRef();
+      const ENTRY & entry = mEntries[iId];
+      return StringRef(entry.data, entry.size);
     }
 
   } //namespace strings
@@ -473,66 +2488,51 @@ std::string& operator<<(std::string& str, const char * value)
   return str;
 }
 
-std::string& operator<<(std::string& str, const int16_t & value)
+template <class T>
+inline std::string & appendNumericT(std::string & str, const T & value)
 {
-  std::stringstream out;
-  out << value;
-  str.append( out.str() );
+  char buffer[ra::strings::TOCHARS_BUFFER_SIZE];
+  size_t length = ra::strings::toChars(buffer, value);
+  str.append(buffer, length);
   return str;
 }
 
+std::string& operator<<(std::string& str, const int16_t & value)
+{
+  return appendNumericT(str, value);
+}
+
 std::string& operator<<(std::string& str, const uint16_t & value)
 {
-  std::stringstream out;
-  out << value;
-  str.append( out.str() );
-  return str;
+  return appendNumericT(str, value);
 }
 
 std::string& operator<<(std::string& str, const int8_t & value)
 {
-  std::stringstream out;
-  out << (int16_t)value;
-  str.append( out.str() );
-  return str;
+  return appendNumericT(str, value);
 }
 
 std::string& operator<<(std::string& str, const uint8_t & value)
 {
-  std::stringstream out;
-  out << (uint16_t)value;
-  str.append( out.str() );
-  return str;
+  return appendNumericT(str, value);
 }
 
 std::string& operator<<(std::string& str, const int32_t & value)
 {
-  std::stringstream out;
-  out << value;
-  str.append( out.str() );
-  return str;
+  return appendNumericT(str, value);
 }
 
 std::string& operator<<(std::string& str, const uint32_t & value)
 {
-  std::stringstream out;
-  out << value;
-  str.append( out.str() );
-  return str;
+  return appendNumericT(str, value);
 }
 
 std::string& operator<<(std::string& str, const int64_t & value)
 {
-  std::stringstream out;
-  out << value;
-  str.append( out.str() );
-  return str;
+  return appendNumericT(str, value);
 }
 
 std::string& operator<<(std::string& str, const uint64_t & value)
 {
-  std::stringstream out;
-  out << value;
-  str.append( out.str() );
-  return str;
+  return appendNumericT(str, value);
 }
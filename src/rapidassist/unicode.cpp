@@ -0,0 +1,385 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "rapidassist/unicode.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RA_UNICODE_SSE2
+#include <emmintrin.h> //for SSE2 intrinsics
+#endif
+
+namespace ra
+{
+  namespace unicode
+  {
+    static const uint32_t MAX_CODE_POINT = 0x10FFFF;
+
+    inline bool isContinuation(unsigned char c)
+    {
+      return (c & 0xC0) == 0x80;
+    }
+
+    inline bool isSurrogate(uint32_t iCodePoint)
+    {
+      return (iCodePoint >= 0xD800 && iCodePoint <= 0xDFFF);
+    }
+
+    //Returns the number of leading ASCII characters in [iFirst, iLast).
+    inline size_t countAscii(const unsigned char * iFirst, const unsigned char * iLast)
+    {
+      const unsigned char * p = iFirst;
+#ifdef RA_UNICODE_SSE2
+      while(iLast - p >= 16)
+      {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)p));
+        if (mask != 0)
+        {
+          //find first non ASCII character
+          for(int j=0; j<16; j++)
+          {
+            if ((mask & (1 << j)) != 0)
+              return (p - iFirst) + j;
+          }
+        }
+        p += 16;
+      }
+#endif
+      while(p != iLast && *p < 0x80)
+        p++;
+      return p - iFirst;
+    }
+
+    //Decodes and validates a multi-byte sequence (Unicode Table 3-7. Well-Formed UTF-8 Byte Sequences).
+    //On success, advances ioPosition after the sequence.
+    inline bool decodeSequence(const unsigned char *& ioPosition, const unsigned char * iLast, uint32_t & oCodePoint)
+    {
+      const unsigned char * p = ioPosition;
+      const unsigned char c = p[0];
+      size_t length;
+      unsigned char min = 0x80; //range of the second byte
+      unsigned char max = 0xBF;
+      if (c >= 0xC2 && c <= 0xDF)
+      {
+        length = 2;
+        oCodePoint = c & 0x1F;
+      }
+      else if (c >= 0xE0 && c <= 0xEF)
+      {
+        length = 3;
+        oCodePoint = c & 0x0F;
+        if (c == 0xE0)
+          min = 0xA0; //overlong
+        else if (c == 0xED)
+          max = 0x9F; //surrogates
+      }
+      else if (c >= 0xF0 && c <= 0xF4)
+      {
+        length = 4;
+        oCodePoint = c & 0x07;
+        if (c == 0xF0)
+          min = 0x90; //overlong
+        else if (c == 0xF4)
+          max = 0x8F; //above U+10FFFF
+      }
+      else
+      {
+        return false;
+      }
+
+      if ((size_t)(iLast - p) < length)
+        return false;
+      if (p[1] < min || p[1] > max)
+        return false;
+      oCodePoint = (oCodePoint << 6) | (p[1] & 0x3F);
+      for(size_t i=2; i<length; i++)
+      {
+        if (!isContinuation(p[i]))
+          return false;
+        oCodePoint = (oCodePoint << 6) | (p[i] & 0x3F);
+      }
+      ioPosition = p + length;
+      return true;
+    }
+
+    bool isValidUtf8(const char * iBuffer, size_t iSize)
+    {
+      if (iBuffer == NULL)
+        return (iSize == 0);
+
+      const unsigned char * p = (const unsigned char *)iBuffer;
+      const unsigned char * last = p + iSize;
+      while(p != last)
+      {
+        p += countAscii(p, last);
+        if (p == last)
+          break;
+        uint32_t codePoint = 0;
+        if (!decodeSequence(p, last, codePoint))
+          return false;
+      }
+      return true;
+    }
+
+    bool isValidUtf8(const std::string & iValue)
+    {
+      return isValidUtf8(iValue.data(), iValue.size());
+    }
+
+    size_t countCodePoints(const char * iBuffer, size_t iSize)
+    {
+      if (iBuffer == NULL)
+        return 0;
+
+      //count all bytes which are not continuation bytes
+      const unsigned char * p = (const unsigned char *)iBuffer;
+      const unsigned char * last = p + iSize;
+      size_t count = 0;
+#ifdef RA_UNICODE_SSE2
+      //continuation bytes are in [0x80, 0xBF] which is [-128, -65] as signed bytes
+      const __m128i limit = _mm_set1_epi8(-64);
+      while(last - p >= 16)
+      {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+        int mask = _mm_movemask_epi8(_mm_cmplt_epi8(chunk, limit));
+        count += 16;
+        for(; mask != 0; mask &= mask - 1)
+          count--;
+        p += 16;
+      }
+#endif
+      for(; p != last; p++)
+      {
+        if (!isContinuation(*p))
+          count++;
+      }
+      return count;
+    }
+
+    inline void appendUtf8(unsigned char *& ioOutput, uint32_t iCodePoint)
+    {
+      unsigned char * o = ioOutput;
+      if (iCodePoint < 0x80)
+      {
+        *o++ = (unsigned char)iCodePoint;
+      }
+      else if (iCodePoint < 0x800)
+      {
+        *o++ = (unsigned char)(0xC0 | (iCodePoint >> 6));
+        *o++ = (unsigned char)(0x80 | (iCodePoint & 0x3F));
+      }
+      else if (iCodePoint < 0x10000)
+      {
+        *o++ = (unsigned char)(0xE0 | (iCodePoint >> 12));
+        *o++ = (unsigned char)(0x80 | ((iCodePoint >> 6) & 0x3F));
+        *o++ = (unsigned char)(0x80 | (iCodePoint & 0x3F));
+      }
+      else
+      {
+        *o++ = (unsigned char)(0xF0 | (iCodePoint >> 18));
+        *o++ = (unsigned char)(0x80 | ((iCodePoint >> 12) & 0x3F));
+        *o++ = (unsigned char)(0x80 | ((iCodePoint >> 6) & 0x3F));
+        *o++ = (unsigned char)(0x80 | (iCodePoint & 0x3F));
+      }
+      ioOutput = o;
+    }
+
+    bool utf8ToUtf16(const char * iBuffer, size_t iSize, Utf16Vector & oUtf16)
+    {
+      oUtf16.clear();
+      if (iBuffer == NULL || iSize == 0)
+        return (iSize == 0);
+
+      //each byte produces at most one code unit
+      oUtf16.resize(iSize);
+      uint16_t * output = &oUtf16[0];
+      const unsigned char * p = (const unsigned char *)iBuffer;
+      const unsigned char * last = p + iSize;
+      while(p != last)
+      {
+        //ASCII fast path
+        size_t count = countAscii(p, last);
+        const unsigned char * asciiEnd = p + count;
+#ifdef RA_UNICODE_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        while(asciiEnd - p >= 16)
+        {
+          __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+          _mm_storeu_si128((__m128i *)output, _mm_unpacklo_epi8(chunk, zero));
+          _mm_storeu_si128((__m128i *)(output + 8), _mm_unpackhi_epi8(chunk, zero));
+          p += 16;
+          output += 16;
+        }
+#endif
+        while(p != asciiEnd)
+          *output++ = *p++;
+        if (p == last)
+          break;
+
+        uint32_t codePoint = 0;
+        if (!decodeSequence(p, last, codePoint))
+        {
+          oUtf16.clear();
+          return false;
+        }
+        if (codePoint >= 0x10000)
+        {
+          codePoint -= 0x10000;
+          *output++ = (uint16_t)(0xD800 + (codePoint >> 10));
+          *output++ = (uint16_t)(0xDC00 + (codePoint & 0x3FF));
+        }
+        else
+        {
+          *output++ = (uint16_t)codePoint;
+        }
+      }
+      oUtf16.resize(output - &oUtf16[0]);
+      return true;
+    }
+
+    bool utf8ToUtf32(const char * iBuffer, size_t iSize, Utf32Vector & oUtf32)
+    {
+      oUtf32.clear();
+      if (iBuffer == NULL || iSize == 0)
+        return (iSize == 0);
+
+      //each byte produces at most one code point
+      oUtf32.resize(iSize);
+      uint32_t * output = &oUtf32[0];
+      const unsigned char * p = (const unsigned char *)iBuffer;
+      const unsigned char * last = p + iSize;
+      while(p != last)
+      {
+        //ASCII fast path
+        size_t count = countAscii(p, last);
+        const unsigned char * asciiEnd = p + count;
+#ifdef RA_UNICODE_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        while(asciiEnd - p >= 16)
+        {
+          __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+          __m128i low = _mm_unpacklo_epi8(chunk, zero);
+          __m128i high = _mm_unpackhi_epi8(chunk, zero);
+          _mm_storeu_si128((__m128i *)output, _mm_unpacklo_epi16(low, zero));
+          _mm_storeu_si128((__m128i *)(output + 4), _mm_unpackhi_epi16(low, zero));
+          _mm_storeu_si128((__m128i *)(output + 8), _mm_unpacklo_epi16(high, zero));
+          _mm_storeu_si128((__m128i *)(output + 12), _mm_unpackhi_epi16(high, zero));
+          p += 16;
+          output += 16;
+        }
+#endif
+        while(p != asciiEnd)
+          *output++ = *p++;
+        if (p == last)
+          break;
+
+        uint32_t codePoint = 0;
+        if (!decodeSequence(p, last, codePoint))
+        {
+          oUtf32.clear();
+          return false;
+        }
+        *output++ = codePoint;
+      }
+      oUtf32.resize(output - &oUtf32[0]);
+      return true;
+    }
+
+    bool utf16ToUtf8(const uint16_t * iBuffer, size_t iCount, std::string & oUtf8)
+    {
+      oUtf8.clear();
+      if (iBuffer == NULL || iCount == 0)
+        return (iCount == 0);
+
+      //each code unit produces at most 3 bytes. A surrogate pair produces 4 bytes.
+      oUtf8.resize(iCount * 3);
+      unsigned char * first = (unsigned char *)&oUtf8[0];
+      unsigned char * output = first;
+      const uint16_t * p = iBuffer;
+      const uint16_t * last = iBuffer + iCount;
+      while(p != last)
+      {
+#ifdef RA_UNICODE_SSE2
+        //ASCII fast path: 8 code units at a time
+        const __m128i asciiMask = _mm_set1_epi16((short)0xFF80);
+        const __m128i zero = _mm_setzero_si128();
+        while(last - p >= 8)
+        {
+          __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+          if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chunk, asciiMask), zero)) != 0xFFFF)
+            break;
+          _mm_storel_epi64((__m128i *)output, _mm_packus_epi16(chunk, chunk));
+          p += 8;
+          output += 8;
+        }
+        if (p == last)
+          break;
+#endif
+        uint32_t codePoint = *p++;
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+        {
+          //high surrogate must be followed by a low surrogate
+          if (p == last || *p < 0xDC00 || *p > 0xDFFF)
+          {
+            oUtf8.clear();
+            return false;
+          }
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (*p++ - 0xDC00);
+        }
+        else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+        {
+          oUtf8.clear();
+          return false;
+        }
+        appendUtf8(output, codePoint);
+      }
+      oUtf8.resize(output - first);
+      return true;
+    }
+
+    bool utf32ToUtf8(const uint32_t * iBuffer, size_t iCount, std::string & oUtf8)
+    {
+      oUtf8.clear();
+      if (iBuffer == NULL || iCount == 0)
+        return (iCount == 0);
+
+      //each code point produces at most 4 bytes
+      oUtf8.resize(iCount * 4);
+      unsigned char * first = (unsigned char *)&oUtf8[0];
+      unsigned char * output = first;
+      for(size_t i=0; i<iCount; i++)
+      {
+        const uint32_t codePoint = iBuffer[i];
+        if (codePoint > MAX_CODE_POINT || isSurrogate(codePoint))
+        {
+          oUtf8.clear();
+          return false;
+        }
+        appendUtf8(output, codePoint);
+      }
+      oUtf8.resize(output - first);
+      return true;
+    }
+
+  } //namespace unicode
+} //namespace ra
@@ -99,6 +99,15 @@ namespace ra { namespace cli { namespace test
       ASSERT_TRUE(found);
       ASSERT_EQ(value, 4123456789ul);
     }
+
+    //test invalid numbers
+    {
+      static const std::string name = "foo";
+      int intValue = 0;
+      size_t sizeValue = 0;
+      ASSERT_FALSE(cli::parseArgument(name.c_str(), intValue, argc, argv));
+      ASSERT_FALSE(cli::parseArgument(name.c_str(), sizeValue, argc, argv));
+    }
   }
   //--------------------------------------------------------------------------------------------------
 } //namespace test
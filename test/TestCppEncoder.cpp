@@ -0,0 +1,791 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestCppEncoder.h"
+#include "rapidassist/cppencoder.h"
+#include "rapidassist/time_.h"
+#include "rapidassist/gtesthelp.h"
+#include "rapidassist/strings.h"
+
+#include <stdio.h> //for printf(), sscanf()
+#include <string>
+#include <map>
+
+namespace ra { namespace cppencoder { namespace test
+{
+
+  //--------------------------------------------------------------------------------------------------
+  void TestCppEncoder::SetUp()
+  {
+  }
+  //--------------------------------------------------------------------------------------------------
+  void TestCppEncoder::TearDown()
+  {
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string getBinaryBuffer(size_t iSize)
+  {
+    //pseudo random bytes
+    std::string buffer;
+    buffer.resize(iSize);
+    uint32_t seed = 0x12345678;
+    for(size_t i=0; i<iSize; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      buffer[i] = (char)(seed >> 24);
+    }
+    return buffer;
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string toHex(const std::string & iValue)
+  {
+    std::string text;
+    text.resize(getHexEncodedSize(iValue.size()) + 1);
+    size_t length = encodeHex((const unsigned char *)iValue.data(), iValue.size(), &text[0]);
+    text.resize(length);
+    return text;
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string toBase64(const std::string & iValue)
+  {
+    std::string text;
+    text.resize(getBase64EncodedSize(iValue.size()) + 1);
+    size_t length = encodeBase64((const unsigned char *)iValue.data(), iValue.size(), &text[0]);
+    text.resize(length);
+    return text;
+  }
+  //--------------------------------------------------------------------------------------------------
+  bool fromHex(const std::string & iText, std::string & oValue)
+  {
+    oValue.resize(getHexDecodedSize(iText.size()) + 1);
+    bool success = decodeHex(iText.data(), iText.size(), (unsigned char *)&oValue[0]);
+    oValue.resize(getHexDecodedSize(iText.size()));
+    return success;
+  }
+  //--------------------------------------------------------------------------------------------------
+  bool fromBase64(const std::string & iText, std::string & oValue)
+  {
+    oValue.resize(getBase64DecodedSize(iText.data(), iText.size()) + 1);
+    bool success = decodeBase64(iText.data(), iText.size(), (unsigned char *)&oValue[0]);
+    oValue.resize(getBase64DecodedSize(iText.data(), iText.size()));
+    return success;
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string toOctString(const std::string & iValue, bool iDisableWarningC4125)
+  {
+    return ra::cppencoder::toOctString((const unsigned char *)iValue.data(), iValue.size(), iDisableWarningC4125);
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string toHexString(const std::string & iValue)
+  {
+    return ra::cppencoder::toHexString((const unsigned char *)iValue.data(), iValue.size());
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string toCppCharactersArray(const std::string & iValue)
+  {
+    return ra::cppencoder::toCppCharactersArray((const unsigned char *)iValue.data(), iValue.size());
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testCharacterClassification)
+  {
+    ASSERT_TRUE( isPrintableCharacter('a') );
+    ASSERT_TRUE( isPrintableCharacter(' ') );
+    ASSERT_TRUE( isPrintableCharacter('~') );
+    ASSERT_FALSE( isPrintableCharacter('\'') );
+    ASSERT_FALSE( isPrintableCharacter('\\') );
+    ASSERT_FALSE( isPrintableCharacter('\n') );
+    ASSERT_FALSE( isPrintableCharacter((char)0x7F) );
+    ASSERT_FALSE( isPrintableCharacter((char)0xE9) );
+
+    ASSERT_TRUE( isControlCharacter('\0') );
+    ASSERT_TRUE( isControlCharacter('\n') );
+    ASSERT_TRUE( isControlCharacter('?') );
+    ASSERT_FALSE( isControlCharacter('a') );
+    ASSERT_FALSE( isControlCharacter((char)0x1B) );
+    ASSERT_EQ(std::string("\\n"), getControlCharacterEscapeString('\n'));
+    ASSERT_EQ(std::string("\\\""), getControlCharacterEscapeString('\"'));
+    ASSERT_TRUE( getControlCharacterEscapeString('a') == NULL );
+
+    ASSERT_TRUE( isHexCharacter('0') );
+    ASSERT_TRUE( isHexCharacter('F') );
+    ASSERT_TRUE( isHexCharacter('f') );
+    ASSERT_FALSE( isHexCharacter('g') );
+    ASSERT_TRUE( isDigitCharacter('9') );
+    ASSERT_FALSE( isDigitCharacter('a') );
+    ASSERT_FALSE( isDigitCharacter((char)0xB9) );
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testToOctString)
+  {
+    ASSERT_EQ(std::string(""), toOctString("", true));
+    ASSERT_EQ(std::string("foo\\tbar\\n"), toOctString("foo\tbar\n", true));
+    ASSERT_EQ(std::string("foo\\0bar"), toOctString(std::string("foo\0bar", 7), true));
+    ASSERT_EQ(std::string("\\377\\061a"), toOctString("\xff" "1a", true));
+    ASSERT_EQ(std::string("\\3771a"), toOctString("\xff" "1a", false));
+
+    //NULL character followed by a digit
+    ASSERT_EQ(std::string("a\\000\\061"), toOctString(std::string("a\0" "1", 3), true));
+    ASSERT_EQ(std::string("a\\0001"), toOctString(std::string("a\0" "1", 3), false));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testToHexString)
+  {
+    ASSERT_EQ(std::string(""), toHexString(""));
+    ASSERT_EQ(std::string("foo\\tbar\\n"), toHexString("foo\tbar\n"));
+    ASSERT_EQ(std::string("foo\\0bar"), toHexString(std::string("foo\0bar", 7)));
+    ASSERT_EQ(std::string("\\xffg"), toHexString("\xff" "g"));
+    ASSERT_EQ(std::string("\\xff\\x61"), toHexString("\xff" "a"));
+    ASSERT_EQ(std::string("a\\x00\\x31"), toHexString(std::string("a\0" "1", 3)));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testToCppCharactersArray)
+  {
+    ASSERT_EQ(std::string(""), toCppCharactersArray(""));
+    ASSERT_EQ(std::string("'a'"), toCppCharactersArray("a"));
+    ASSERT_EQ(std::string("'a',0,200,39,92,9"), toCppCharactersArray(std::string("a\0\xc8'\\\t", 6)));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testToStringReentrant)
+  {
+    //returned strings must not be overwritten by the next call
+    const char * oct1 = ra::cppencoder::toOctString((unsigned char)1);
+    const char * oct2 = ra::cppencoder::toOctString((unsigned char)255);
+    ASSERT_EQ(std::string("\\001"), oct1);
+    ASSERT_EQ(std::string("\\377"), oct2);
+    const char * hex1 = ra::cppencoder::toHexString((unsigned char)1);
+    const char * hex2 = ra::cppencoder::toHexString((unsigned char)255);
+    ASSERT_EQ(std::string("\\x01"), hex1);
+    ASSERT_EQ(std::string("\\xff"), hex2);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testToStringParallel)
+  {
+    //chunk seams inside long runs of digits following escape sequences
+    std::string digits;
+    while(digits.size() < 1536*1024)
+    {
+      digits.append("\xff");
+      digits.append(std::string(200000, '7'));
+      digits.append(std::string("\0", 1));
+      digits.append("123456789abcdef");
+    }
+    const std::string buffers[] = {
+      getBinaryBuffer(1536*1024 + 17),
+      digits,
+      std::string(1536*1024, '\0'),
+      std::string(1536*1024, '5'),
+      "foo\tbar",
+    };
+    for(size_t i=0; i<sizeof(buffers)/sizeof(buffers[0]); i++)
+    {
+      const unsigned char * data = (const unsigned char *)buffers[i].data();
+      const size_t size = buffers[i].size();
+      const std::string octWarning = ra::cppencoder::toOctString(data, size, true);
+      const std::string oct = ra::cppencoder::toOctString(data, size, false);
+      const std::string hex = ra::cppencoder::toHexString(data, size);
+      const std::string array = ra::cppencoder::toCppCharactersArray(data, size);
+      for(size_t numThreads = 0; numThreads <= 5; numThreads++)
+      {
+        ASSERT_TRUE( octWarning == toOctStringParallel(data, size, true, numThreads) ) << "buffer " << i << " with " << numThreads << " threads";
+        ASSERT_TRUE( oct == toOctStringParallel(data, size, false, numThreads) ) << "buffer " << i << " with " << numThreads << " threads";
+        ASSERT_TRUE( hex == toHexStringParallel(data, size, numThreads) ) << "buffer " << i << " with " << numThreads << " threads";
+        ASSERT_TRUE( array == toCppCharactersArrayParallel(data, size, numThreads) ) << "buffer " << i << " with " << numThreads << " threads";
+      }
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  bool writeFile(const std::string & iFilePath, const std::string & iContent)
+  {
+    FILE * f = fopen(iFilePath.c_str(), "wb");
+    if (!f)
+      return false;
+    size_t written = fwrite(iContent.data(), 1, iContent.size(), f);
+    fclose(f);
+    return (written == iContent.size());
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string readFile(const std::string & iFilePath)
+  {
+    std::string content;
+    FILE * f = fopen(iFilePath.c_str(), "rb");
+    if (!f)
+      return content;
+    char buffer[4096];
+    size_t read = 0;
+    while( (read = fread(buffer, 1, sizeof(buffer), f)) > 0 )
+      content.append(buffer, read);
+    fclose(f);
+    return content;
+  }
+  //--------------------------------------------------------------------------------------------------
+  //Returns the encoded content of a source file generated by encodeFile().
+  //The content of each line is validated against the given maximum line length.
+  std::string getEncodedContent(const std::string & iSource, bool iIsArray, size_t iLineLength)
+  {
+    ra::strings::StringVector lines;
+    ra::strings::splitString(lines, iSource, "\n");
+    std::string content;
+    bool inData = false;
+    for(size_t i=0; i<lines.size(); i++)
+    {
+      const std::string & line = lines[i];
+      if (line.find("[] =") != std::string::npos)
+      {
+        inData = true;
+        continue;
+      }
+      if (!inData)
+        continue;
+      if (line.find("extern const size_t") == 0 || line == "};")
+        break;
+
+      std::string value = line;
+      if (!iIsArray)
+      {
+        //remove quotes and the terminating semicolon
+        if (value.size() > 0 && value[value.size()-1] == ';')
+          value.erase(value.size()-1);
+        EXPECT_TRUE( value.size() >= 2 && value[0] == '"' && value[value.size()-1] == '"' ) << value;
+        value = value.substr(1, value.size() - 2);
+      }
+      if (iLineLength > 0)
+      {
+        EXPECT_LE(value.size(), iLineLength);
+      }
+      content.append(value);
+    }
+    if (iIsArray && !content.empty())
+      content.erase(content.size()-1); //last separator
+    return content;
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testEncodeFile)
+  {
+    const std::string inputFile = ra::gtesthelp::getTestQualifiedName() + ".bin";
+    const std::string outputFile = ra::gtesthelp::getTestQualifiedName() + ".cpp";
+
+    //NULL characters and octal escape sequences followed by digits across chunk boundaries
+    std::string buffer = getBinaryBuffer(200000);
+    buffer.replace(65535, 2, std::string("\0" "1", 2));
+    buffer.replace(2*65536-2, 4, "\xff" "123");
+    ASSERT_TRUE( writeFile(inputFile, buffer) );
+
+    const unsigned char * data = (const unsigned char *)buffer.data();
+    const CPP_ENCODING encodings[] = {ENCODING_OCT_STRING, ENCODING_HEX_STRING, ENCODING_CHARACTERS_ARRAY};
+    const std::string expected[] = {
+      ra::cppencoder::toOctString(data, buffer.size()),
+      ra::cppencoder::toHexString(data, buffer.size()),
+      ra::cppencoder::toCppCharactersArray(data, buffer.size()),
+    };
+    for(size_t i=0; i<sizeof(encodings)/sizeof(encodings[0]); i++)
+    {
+      static const size_t LINE_LENGTH = 100;
+      ASSERT_TRUE( encodeFile(inputFile.c_str(), outputFile.c_str(), "foo", encodings[i], LINE_LENGTH) );
+      const std::string source = readFile(outputFile);
+      ASSERT_NE(std::string::npos, source.find("extern const size_t foo_size = 200000;\n"));
+
+      const bool isArray = (encodings[i] == ENCODING_CHARACTERS_ARRAY);
+      ASSERT_NE(std::string::npos, source.find(isArray ? "extern const unsigned char foo[] = {\n" : "extern const char foo[] =\n\""));
+      const std::string content = getEncodedContent(source, isArray, LINE_LENGTH);
+      ASSERT_EQ(expected[i], content) << "with encoding " << i;
+    }
+
+    //without line wrapping
+    ASSERT_TRUE( writeFile(inputFile, "foo\tbar\n") );
+    ASSERT_TRUE( encodeFile(inputFile.c_str(), outputFile.c_str(), "foo", ENCODING_OCT_STRING, 0) );
+    ASSERT_EQ(std::string(
+      "#include <stddef.h>\n"
+      "\n"
+      "extern const char foo[] =\n"
+      "\"foo\\tbar\\n\";\n"
+      "extern const size_t foo_size = 8;\n"), readFile(outputFile));
+
+    //empty file
+    ASSERT_TRUE( writeFile(inputFile, "") );
+    ASSERT_TRUE( encodeFile(inputFile.c_str(), outputFile.c_str(), "foo", ENCODING_CHARACTERS_ARRAY, 0) );
+    ASSERT_EQ(std::string(
+      "#include <stddef.h>\n"
+      "\n"
+      "extern const unsigned char foo[] = {\n"
+      "0\n"
+      "};\n"
+      "extern const size_t foo_size = 0;\n"), readFile(outputFile));
+
+    //missing input file
+    ASSERT_FALSE( encodeFile("missing.bin", outputFile.c_str(), "foo", ENCODING_OCT_STRING, 0) );
+
+    remove(inputFile.c_str());
+    remove(outputFile.c_str());
+  }
+  //--------------------------------------------------------------------------------------------------
+  //Interprets the code generated by toCppSource() and returns the decoded buffer.
+  std::string decodeCppSource(const std::string & iSource, const std::string & iName)
+  {
+    ra::strings::StringVector lines;
+    ra::strings::splitString(lines, iSource, "\n");
+
+    //read the content of each block
+    std::map<std::string, std::string> blocks;
+    const std::string sizePrefix = "extern const size_t " + iName + "_size = ";
+    unsigned long size = 0;
+    char name[64];
+    for(size_t i=0; i<lines.size(); i++)
+    {
+      const std::string & line = lines[i];
+      if (sscanf(line.c_str(), "static const char %63[^[][] =", name) == 1)
+      {
+        //concatenate the lines of the string literal
+        std::string literal;
+        while(++i < lines.size())
+        {
+          std::string value = lines[i];
+          const bool isLast = (value.size() > 0 && value[value.size()-1] == ';');
+          if (isLast)
+            value.erase(value.size()-1);
+          EXPECT_TRUE( value.size() >= 2 && value[0] == '"' && value[value.size()-1] == '"' ) << value;
+          literal.append(value.substr(1, value.size() - 2));
+          if (isLast)
+            break;
+        }
+        std::string & content = blocks[name];
+        content.assign(literal.size(), '\0');
+        size_t contentSize = 0;
+        EXPECT_TRUE( decodeStringLiteral(literal.data(), literal.size(), (unsigned char *)&content[0], contentSize) ) << name;
+        content.resize(contentSize);
+      }
+      else if (sscanf(line.c_str(), "static const unsigned int %63[^[][] = {", name) == 1)
+      {
+        //read the words as little endian bytes
+        std::string & content = blocks[name];
+        while(++i < lines.size() && lines[i] != "};")
+        {
+          ra::strings::StringVector words;
+          ra::strings::splitString(words, lines[i], ",");
+          for(size_t j=0; j<words.size(); j++)
+          {
+            if (words[j].empty())
+              continue;
+            EXPECT_TRUE( words[j].size() > 2 && words[j].size() <= 10 && words[j].substr(0, 2) == "0x" ) << words[j];
+            const std::string digits = words[j].substr(2);
+            uint32_t word = 0;
+            EXPECT_EQ(ra::strings::FROMCHARS_SUCCESS, ra::strings::fromChars(digits.c_str(), digits.c_str() + digits.size(), word, 16).error) << words[j];
+            for(size_t k=0; k<4; k++)
+              content.push_back((char)(word >> (8*k)));
+          }
+        }
+      }
+      else if (line.find(sizePrefix) == 0)
+      {
+        sscanf(line.c_str() + sizePrefix.size(), "%lu", &size);
+      }
+    }
+
+    //execute the statements of the decoding function
+    std::string output(size, '\x55');
+    for(size_t i=0; i<lines.size(); i++)
+    {
+      const std::string & line = lines[i];
+      unsigned long offset = 0;
+      unsigned long length = 0;
+      unsigned long value = 0;
+      if (sscanf(line.c_str(), "  memcpy(oBuffer + %lu, %63[^,], %lu);", &offset, name, &length) == 3 ||
+          sscanf(line.c_str(), "  for(size_t i=0; i<%lu; i++) oBuffer[%lu + i] = (unsigned char)(%63[^[]", &length, &offset, name) == 3)
+      {
+        EXPECT_TRUE( blocks.find(name) != blocks.end() ) << name;
+        EXPECT_GE(blocks[name].size(), length) << name;
+        EXPECT_LE(offset + length, output.size());
+        output.replace(offset, length, blocks[name].substr(0, length));
+      }
+      else if (sscanf(line.c_str(), "  memset(oBuffer + %lu, %lu, %lu);", &offset, &value, &length) == 3)
+      {
+        EXPECT_LE(offset + length, output.size());
+        output.replace(offset, length, std::string(length, (char)value));
+      }
+    }
+    return output;
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testToCppSource)
+  {
+    //text, padding and binary data
+    std::string buffer;
+    while(buffer.size() < 10000)
+      buffer.append("The quick brown fox jumps over the lazy dog 0123456789.\n");
+    buffer.resize(10000);
+    buffer.append(std::string(20000, '\0'));
+    buffer.append(getBinaryBuffer(10000));
+
+    BlockEncodingList blocks;
+    const std::string source = toCppSource((const unsigned char *)buffer.data(), buffer.size(), "foo", blocks);
+    ASSERT_NE(std::string::npos, source.find("extern const size_t foo_size = 40000;\n"));
+    ASSERT_NE(std::string::npos, source.find("void foo_decode(unsigned char * oBuffer)\n"));
+    ASSERT_NE(std::string::npos, source.find("  memset(oBuffer + 10000, 0, 20000);\n"));
+
+    //blocks must cover the whole buffer
+    ASSERT_FALSE( blocks.empty() );
+    size_t offset = 0;
+    size_t encodedSize = 0;
+    for(size_t i=0; i<blocks.size(); i++)
+    {
+      const BLOCK_ENCODING & block = blocks[i];
+      ASSERT_EQ(offset, block.offset);
+      ASSERT_GT(block.size, 0);
+      ASSERT_GT(block.encodedSize, 0);
+      offset += block.size;
+      encodedSize += block.encodedSize;
+
+      //expected strategy of each part of the buffer
+      if (block.offset + block.size <= 10000)
+      {
+        ASSERT_EQ(STRATEGY_STRING_LITERAL, block.strategy);
+      }
+      else if (block.offset >= 10000 && block.offset + block.size <= 30000)
+      {
+        ASSERT_EQ(STRATEGY_RUN_LENGTH, block.strategy);
+      }
+      else if (block.offset >= 30000)
+      {
+        ASSERT_EQ(STRATEGY_UINT32_ARRAY, block.strategy);
+      }
+    }
+    ASSERT_EQ(buffer.size(), offset);
+    ASSERT_LT(encodedSize, source.size());
+
+    //the generated code must decode to the original buffer
+    ASSERT_EQ(buffer, decodeCppSource(source, "foo"));
+
+    //small buffers with partial 32 bits words
+    for(size_t length = 1; length <= 64; length++)
+    {
+      const std::string binary = getBinaryBuffer(length);
+      const std::string small = toCppSource((const unsigned char *)binary.data(), binary.size(), "bar", blocks);
+      ASSERT_EQ(binary, decodeCppSource(small, "bar")) << "length=" << length;
+    }
+
+    //the generated code must be smaller than the other encoders
+    ASSERT_LT(source.size(), ra::cppencoder::toOctString((const unsigned char *)buffer.data(), buffer.size()).size());
+    ASSERT_LT(source.size(), ra::cppencoder::toCppCharactersArray((const unsigned char *)buffer.data(), buffer.size()).size());
+
+    //empty buffer
+    const std::string empty = toCppSource(NULL, 0, "foo", blocks);
+    ASSERT_TRUE( blocks.empty() );
+    ASSERT_NE(std::string::npos, empty.find("extern const size_t foo_size = 0;\n"));
+    ASSERT_EQ(std::string(), decodeCppSource(empty, "foo"));
+  }
+  //--------------------------------------------------------------------------------------------------
+  bool decodeLiteral(const std::string & iText, std::string & oBuffer)
+  {
+    oBuffer.assign(iText.size(), '\0');
+    size_t size = 0;
+    bool success = decodeStringLiteral(iText.data(), iText.size(), (unsigned char *)&oBuffer[0], size);
+    oBuffer.resize(size);
+    return success;
+  }
+  //--------------------------------------------------------------------------------------------------
+  bool decodeArray(const std::string & iText, std::string & oBuffer)
+  {
+    oBuffer.assign(iText.size(), '\0');
+    size_t size = 0;
+    bool success = decodeCharactersArray(iText.data(), iText.size(), (unsigned char *)&oBuffer[0], size);
+    oBuffer.resize(size);
+    return success;
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testDecodeStringLiteral)
+  {
+    std::string output;
+    ASSERT_TRUE( decodeLiteral("", output) );
+    ASSERT_EQ(std::string(""), output);
+    ASSERT_TRUE( decodeLiteral("foo\\tbar\\n", output) );
+    ASSERT_EQ(std::string("foo\tbar\n"), output);
+    ASSERT_TRUE( decodeLiteral("\\3771a", output) );
+    ASSERT_EQ(std::string("\xff" "1a"), output);
+    ASSERT_TRUE( decodeLiteral("a\\0001\\0", output) );
+    ASSERT_EQ(std::string("a\0" "1\0", 4), output);
+    ASSERT_TRUE( decodeLiteral("\\xffg\\x7\\x41", output) );
+    ASSERT_EQ(std::string("\xff" "g\x07" "A"), output);
+    ASSERT_TRUE( decodeLiteral("\\a\\b\\f\\v\\r\\\"\\'\\?\\\\", output) );
+    ASSERT_EQ(std::string("\a\b\f\v\r\"'?\\"), output);
+
+    //invalid escape sequences
+    ASSERT_FALSE( decodeLiteral("\\", output) );
+    ASSERT_FALSE( decodeLiteral("abc\\x", output) );
+    ASSERT_FALSE( decodeLiteral("\\xg", output) );
+    ASSERT_FALSE( decodeLiteral("\\q", output) );
+    ASSERT_FALSE( decodeLiteral("\\8", output) );
+    ASSERT_FALSE( decodeLiteral("\\400", output) );
+    ASSERT_FALSE( decodeLiteral("\\x100", output) );
+    ASSERT_FALSE( decodeLiteral("a\"b", output) );
+
+    //round trip
+    std::string digits;
+    for(size_t i=0; i<100; i++)
+    {
+      digits.append(std::string("\0", 1));
+      digits.append("0123456789abcdefABCDEF\xff\\\"?");
+    }
+    const std::string binary = getBinaryBuffer(100000);
+    const std::string buffers[] = {binary, digits, "The quick brown fox jumps over the lazy dog.\n"};
+    for(size_t i=0; i<sizeof(buffers)/sizeof(buffers[0]); i++)
+    {
+      const std::string & buffer = buffers[i];
+      ASSERT_TRUE( decodeLiteral(toOctString(buffer, true), output) );
+      ASSERT_EQ(buffer, output);
+      ASSERT_TRUE( decodeLiteral(toOctString(buffer, false), output) );
+      ASSERT_EQ(buffer, output);
+      ASSERT_TRUE( decodeLiteral(toHexString(buffer), output) );
+      ASSERT_EQ(buffer, output);
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testDecodeCharactersArray)
+  {
+    std::string output;
+    ASSERT_TRUE( decodeArray("", output) );
+    ASSERT_EQ(std::string(""), output);
+    ASSERT_TRUE( decodeArray("'a',0,200,39,92,9", output) );
+    ASSERT_EQ(std::string("a\0\xc8'\\\t", 6), output);
+    ASSERT_TRUE( decodeArray(" 'a' ,\n 255,\t", output) );
+    ASSERT_EQ(std::string("a\xff"), output);
+
+    //invalid values
+    ASSERT_FALSE( decodeArray("256", output) );
+    ASSERT_FALSE( decodeArray("1000", output) );
+    ASSERT_FALSE( decodeArray("'a", output) );
+    ASSERT_FALSE( decodeArray("1 2", output) );
+    ASSERT_FALSE( decodeArray("1,,2", output) );
+    ASSERT_FALSE( decodeArray("0x10", output) );
+
+    //round trip
+    const std::string binary = getBinaryBuffer(100000);
+    ASSERT_TRUE( decodeArray(toCppCharactersArray(binary), output) );
+    ASSERT_EQ(binary, output);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testHex)
+  {
+    ASSERT_EQ(0, getHexEncodedSize(0));
+    ASSERT_EQ(6, getHexEncodedSize(3));
+    ASSERT_EQ(3, getHexDecodedSize(6));
+
+    ASSERT_EQ(std::string(""), toHex(""));
+    ASSERT_EQ(std::string("00ff7f80"), toHex(std::string("\x00\xff\x7f\x80", 4)));
+    ASSERT_EQ(std::string("48656c6c6f20576f726c6421"), toHex("Hello World!"));
+
+    std::string value;
+    ASSERT_TRUE( fromHex("48656c6c6f20576f726c6421", value) );
+    ASSERT_EQ(std::string("Hello World!"), value);
+    ASSERT_TRUE( fromHex("00FF7f80", value) );
+    ASSERT_EQ(std::string("\x00\xff\x7f\x80", 4), value);
+
+    //invalid
+    ASSERT_FALSE( fromHex("abc", value) );
+    ASSERT_FALSE( fromHex("zz", value) );
+    ASSERT_FALSE( fromHex("0g", value) );
+
+    //an invalid character at any position (SSE2 and scalar paths)
+    const std::string text = toHex(getBinaryBuffer(40));
+    for(size_t i=0; i<text.size(); i++)
+    {
+      static const char * invalidCharacters = "g/:@G`\x80\xff ";
+      for(const char * c = invalidCharacters; *c != '\0'; c++)
+      {
+        std::string invalid = text;
+        invalid[i] = *c;
+        ASSERT_FALSE( fromHex(invalid, value) ) << "at offset " << i;
+      }
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testBase64)
+  {
+    //RFC 4648 test vectors
+    ASSERT_EQ(std::string(""), toBase64(""));
+    ASSERT_EQ(std::string("Zg=="), toBase64("f"));
+    ASSERT_EQ(std::string("Zm8="), toBase64("fo"));
+    ASSERT_EQ(std::string("Zm9v"), toBase64("foo"));
+    ASSERT_EQ(std::string("Zm9vYg=="), toBase64("foob"));
+    ASSERT_EQ(std::string("Zm9vYmE="), toBase64("fooba"));
+    ASSERT_EQ(std::string("Zm9vYmFy"), toBase64("foobar"));
+    ASSERT_EQ(std::string("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw=="), toBase64("The quick brown fox jumps over the lazy dog"));
+    ASSERT_EQ(std::string("+/+/"), toBase64("\xfb\xff\xbf"));
+
+    std::string value;
+    ASSERT_TRUE( fromBase64("", value) );
+    ASSERT_EQ(std::string(""), value);
+    ASSERT_TRUE( fromBase64("Zm9vYmE=", value) );
+    ASSERT_EQ(std::string("fooba"), value);
+    ASSERT_TRUE( fromBase64("Zm9vYg==", value) );
+    ASSERT_EQ(std::string("foob"), value);
+    ASSERT_TRUE( fromBase64("Zm9vYg", value) ); //without padding
+    ASSERT_EQ(std::string("foob"), value);
+    ASSERT_TRUE( fromBase64("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw==", value) );
+    ASSERT_EQ(std::string("The quick brown fox jumps over the lazy dog"), value);
+
+    //invalid
+    ASSERT_FALSE( fromBase64("Z", value) );
+    ASSERT_FALSE( fromBase64("Zm9vY", value) );
+    ASSERT_FALSE( fromBase64("Zg=a", value) );
+    ASSERT_FALSE( fromBase64("Z===", value) );
+    ASSERT_FALSE( fromBase64("Zm 9", value) );
+
+    //an invalid character at any position (SSE2 and scalar paths)
+    const std::string text = toBase64(getBinaryBuffer(48));
+    for(size_t i=0; i<text.size(); i++)
+    {
+      static const char * invalidCharacters = "=-_.@[`{ \x80\xff";
+      for(const char * c = invalidCharacters; *c != '\0'; c++)
+      {
+        if (*c == '=' && i + 1 == text.size())
+          continue; //valid padding
+        std::string invalid = text;
+        invalid[i] = *c;
+        ASSERT_FALSE( fromBase64(invalid, value) ) << "at offset " << i;
+      }
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testHexBase64RoundTrip)
+  {
+    for(size_t size=0; size<200; size++)
+    {
+      const std::string buffer = getBinaryBuffer(size);
+
+      //hex must match the per character escape sequences
+      const std::string hex = toHex(buffer);
+      ASSERT_EQ(getHexEncodedSize(size), hex.size());
+      for(size_t i=0; i<size; i++)
+      {
+        ASSERT_EQ(std::string(ra::cppencoder::toHexString((unsigned char)buffer[i]) + 2), hex.substr(i*2, 2));
+      }
+      std::string decoded;
+      ASSERT_TRUE( fromHex(hex, decoded) );
+      ASSERT_EQ(buffer, decoded);
+
+      const std::string base64 = toBase64(buffer);
+      ASSERT_EQ(getBase64EncodedSize(size), base64.size());
+      ASSERT_EQ(size, getBase64DecodedSize(base64.data(), base64.size()));
+      ASSERT_TRUE( fromBase64(base64, decoded) );
+      ASSERT_EQ(buffer, decoded);
+
+      //unpadded
+      const std::string unpadded = base64.substr(0, base64.find('='));
+      ASSERT_EQ(size, getBase64DecodedSize(unpadded.data(), unpadded.size()));
+      ASSERT_TRUE( fromBase64(unpadded, decoded) );
+      ASSERT_EQ(buffer, decoded);
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testHexBase64Performance)
+  {
+    static const size_t BUFFER_SIZE = 16 * 1024 * 1024;
+    const std::string buffer = getBinaryBuffer(BUFFER_SIZE);
+    const double megabytes = (double)BUFFER_SIZE / (1024.0 * 1024.0);
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    const std::string hex = toHex(buffer);
+    double timeEncodeHex = ra::time::getMicrosecondsTimer() - timeStart;
+
+    std::string decoded;
+    timeStart = ra::time::getMicrosecondsTimer();
+    ASSERT_TRUE( fromHex(hex, decoded) );
+    double timeDecodeHex = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_EQ(buffer, decoded);
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    const std::string base64 = toBase64(buffer);
+    double timeEncodeBase64 = ra::time::getMicrosecondsTimer() - timeStart;
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    ASSERT_TRUE( fromBase64(base64, decoded) );
+    double timeDecodeBase64 = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_EQ(buffer, decoded);
+
+    printf("encodeHex(): %.0f MB/s\n", megabytes / timeEncodeHex);
+    printf("decodeHex(): %.0f MB/s\n", megabytes / timeDecodeHex);
+    printf("encodeBase64(): %.0f MB/s\n", megabytes / timeEncodeBase64);
+    printf("decodeBase64(): %.0f MB/s\n", megabytes / timeDecodeBase64);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestCppEncoder, testCppEncoderPerformance)
+  {
+    static const size_t BUFFER_SIZE = 8 * 1024 * 1024;
+    const std::string binary = getBinaryBuffer(BUFFER_SIZE);
+    std::string text;
+    while(text.size() < BUFFER_SIZE)
+      text.append("The quick brown fox jumps over the lazy dog 0123456789.\n");
+    const double megabytes = (double)BUFFER_SIZE / (1024.0 * 1024.0);
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    std::string output = toOctString(binary, true);
+    double timeOctBinary = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_FALSE( output.empty() );
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    output = toOctString(text, true);
+    double timeOctText = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_FALSE( output.empty() );
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    output = toHexString(binary);
+    double timeHexBinary = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_FALSE( output.empty() );
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    output = toCppCharactersArray(binary);
+    double timeArrayBinary = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_FALSE( output.empty() );
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    output = toOctStringParallel((const unsigned char *)binary.data(), binary.size(), true, 0);
+    double timeOctParallel = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_FALSE( output.empty() );
+
+    std::string encoded = toOctString(binary, true);
+    std::string decoded(encoded.size(), '\0');
+    size_t decodedSize = 0;
+    timeStart = ra::time::getMicrosecondsTimer();
+    ASSERT_TRUE( decodeStringLiteral(encoded.data(), encoded.size(), (unsigned char *)&decoded[0], decodedSize) );
+    double timeDecodeOct = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_EQ(binary.size(), decodedSize);
+
+    encoded = toOctString(text, true);
+    decoded.assign(encoded.size(), '\0');
+    timeStart = ra::time::getMicrosecondsTimer();
+    ASSERT_TRUE( decodeStringLiteral(encoded.data(), encoded.size(), (unsigned char *)&decoded[0], decodedSize) );
+    double timeDecodeText = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_EQ(text.size(), decodedSize);
+
+    printf("toOctString() binary: %.0f MB/s\n", megabytes / timeOctBinary);
+    printf("toOctStringParallel() binary: %.0f MB/s\n", megabytes / timeOctParallel);
+    printf("toOctString() text: %.0f MB/s\n", megabytes / timeOctText);
+    printf("toHexString() binary: %.0f MB/s\n", megabytes / timeHexBinary);
+    printf("toCppCharactersArray() binary: %.0f MB/s\n", megabytes / timeArrayBinary);
+    printf("decodeStringLiteral() binary: %.0f MB/s\n", megabytes / timeDecodeOct);
+    printf("decodeStringLiteral() text: %.0f MB/s\n", megabytes / timeDecodeText);
+  }
+  //--------------------------------------------------------------------------------------------------
+} //namespace test
+} //namespace cppencoder
+} //namespace ra
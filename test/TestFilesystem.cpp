@@ -31,6 +31,9 @@
 #ifndef _WIN32
 #include <linux/fs.h>
 #include <sys/ioctl.h> //for ioctl()
+#include <unistd.h> //for ftruncate()
+#include <sys/socket.h> //for socket()
+#include <sys/un.h> //for sockaddr_un
 #endif
 
 namespace ra { namespace filesystem { namespace test
@@ -186,6 +189,104 @@ namespace ra { namespace filesystem { namespace test
 
   }
   //--------------------------------------------------------------------------------------------------
+  TEST_F(TestFilesystem, testGetFileSize64)
+  {
+    //test NULL
+    ASSERT_EQ(0, filesystem::getFileSize64((const char *)NULL));
+    ASSERT_EQ(0, filesystem::getFileSize64((FILE *)NULL));
+    ASSERT_EQ(0, filesystem::getFileDescriptorSize64(-1));
+
+    //test actual value
+    std::string filename = ra::gtesthelp::getTestQualifiedName();
+    static const uint64_t EXPECTED = 12345;
+    FILE * ptr = fopen(filename.c_str(), "wb");
+    ASSERT_TRUE(ptr != NULL);
+    std::string content((size_t)EXPECTED, 'a');
+    fwrite(content.data(), 1, content.size(), ptr);
+    fclose(ptr);
+
+    ASSERT_EQ(EXPECTED, filesystem::getFileSize64(filename.c_str()));
+
+    ptr = fopen(filename.c_str(), "rb");
+    ASSERT_TRUE(ptr != NULL);
+    ASSERT_EQ(0, fseek(ptr, 100, SEEK_SET));
+    ASSERT_EQ(EXPECTED, filesystem::getFileSize64(ptr));
+    ASSERT_EQ(EXPECTED, filesystem::getFileDescriptorSize64(fileno(ptr)));
+
+    //the position of the stream must not be modified
+    ASSERT_EQ(100, ftell(ptr));
+    fclose(ptr);
+
+    //getFileSize() includes the data not flushed yet, getFileSize64() does not
+    ptr = fopen(filename.c_str(), "wb");
+    ASSERT_TRUE(ptr != NULL);
+    fwrite(content.data(), 1, 10, ptr);
+    ASSERT_EQ(10, filesystem::getFileSize(ptr));
+    ASSERT_EQ(10, ftell(ptr));
+    fflush(ptr);
+    ASSERT_EQ(10, filesystem::getFileSize64(ptr));
+    fclose(ptr);
+
+#ifndef _WIN32
+    //size of a file bigger than 4 GB.
+    //Windows is not tested since _chsize_s() fills the file with zeros instead of creating a sparse file.
+    static const uint64_t SPARSE_SIZE = 0x100000000ull + 10;
+    ptr = fopen(filename.c_str(), "wb");
+    ASSERT_TRUE(ptr != NULL);
+    bool sparse = (sizeof(off_t) >= sizeof(uint64_t) && ftruncate(fileno(ptr), (off_t)SPARSE_SIZE) == 0);
+    fclose(ptr);
+    if (sparse)
+      ASSERT_EQ(SPARSE_SIZE, filesystem::getFileSize64(filename.c_str()));
+    else
+      printf("Skipping 4 GB file size test. Unable to create a sparse file.\n");
+#endif
+
+    remove(filename.c_str());
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestFilesystem, testGetFileInfo)
+  {
+    FILE_INFO info;
+
+    //test NULL and empty paths
+    ASSERT_FALSE( filesystem::getFileInfo(NULL, info) );
+    ASSERT_EQ(ENTRY_NOT_FOUND, info.type);
+    ASSERT_FALSE( filesystem::getFileInfo("", info) );
+    ASSERT_EQ(ENTRY_NOT_FOUND, info.type);
+
+    //test file
+    std::string filename = ra::gtesthelp::getTestQualifiedName();
+    uint64_t createTime = (uint64_t)::time(NULL);
+    ASSERT_TRUE( ra::gtesthelp::createFile(filename.c_str(), 12345) );
+    ASSERT_TRUE( filesystem::getFileInfo(filename.c_str(), info) );
+    ASSERT_EQ(ENTRY_FILE, info.type);
+    ASSERT_EQ(12345, info.size);
+    ASSERT_GE(info.modifiedTime + 2, createTime); //allow file systems with a 2 seconds resolution
+    ASSERT_LE(info.modifiedTime, (uint64_t)::time(NULL) + 2);
+    ASSERT_LT(info.modifiedTimeNanoseconds, 1000000000u);
+    ASSERT_NE(0u, info.mode);
+
+    //test folder
+    std::string folder = filesystem::getCurrentFolder();
+    ASSERT_TRUE( filesystem::getFileInfo(folder.c_str(), info) );
+    ASSERT_EQ(ENTRY_FOLDER, info.type);
+
+    //test batch query
+    ra::strings::StringVector paths;
+    paths.push_back(filename);
+    paths.push_back(folder);
+    paths.push_back(filename + ".notfound");
+    FileInfoList infos;
+    ASSERT_EQ(2, filesystem::getFileInfo(paths, infos));
+    ASSERT_EQ(paths.size(), infos.size());
+    ASSERT_EQ(ENTRY_FILE, infos[0].type);
+    ASSERT_EQ(ENTRY_FOLDER, infos[1].type);
+    ASSERT_EQ(ENTRY_NOT_FOUND, infos[2].type);
+    ASSERT_EQ(0, infos[2].size);
+
+    remove(filename.c_str());
+  }
+  //--------------------------------------------------------------------------------------------------
   TEST_F(TestFilesystem, testGetFilename)
   {
     //test NULL
@@ -342,6 +443,22 @@ namespace ra { namespace filesystem { namespace test
       ASSERT_FALSE(hasJettaFile);
     }
 
+    //test StringList output matches StringVector output
+    {
+      ra::strings::StringVector expectedFiles;
+      bool success = filesystem::findFiles(expectedFiles, basePath.c_str());
+      ASSERT_TRUE(success);
+
+      ra::strings::StringList files;
+      success = filesystem::findFiles(files, basePath.c_str());
+      ASSERT_TRUE(success);
+      ASSERT_EQ(expectedFiles.size(), files.size());
+      for(size_t i=0; i<files.size(); i++)
+      {
+        ASSERT_EQ(expectedFiles[i], files[i].toString());
+      }
+    }
+
     //test root file system
     {
 #ifdef _WIN32
@@ -549,6 +666,34 @@ namespace ra { namespace filesystem { namespace test
       //assert folder is actually deleted
       ASSERT_FALSE( filesystem::folderExists(basePath.c_str()) );
     }
+
+#ifndef _WIN32
+    //test a folder which contains an entry which is neither a file nor a folder
+    {
+      std::string folder = ra::gtesthelp::getTestQualifiedName() + "." + ra::strings::toString(__LINE__);
+      ASSERT_TRUE( filesystem::createFolder(folder.c_str()) );
+
+      std::string socketPath = folder + getPathSeparatorStr() + "socket";
+      sockaddr_un address;
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      ASSERT_LT(socketPath.size(), sizeof(address.sun_path));
+      strcpy(address.sun_path, socketPath.c_str());
+
+      int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+      ASSERT_NE(-1, fd);
+      ASSERT_EQ(0, bind(fd, (sockaddr*)&address, sizeof(address)));
+      close(fd);
+
+      FILE_INFO info;
+      ASSERT_TRUE( filesystem::getFileInfo(socketPath.c_str(), info) );
+      ASSERT_EQ(ENTRY_OTHER, info.type);
+
+      bool success = filesystem::deleteFolder(folder.c_str());
+      ASSERT_TRUE(success);
+      ASSERT_FALSE( filesystem::folderExists(folder.c_str()) );
+    }
+#endif
   }
   //--------------------------------------------------------------------------------------------------
   TEST_F(TestFilesystem, testGetTemporaryFileName)
@@ -184,5 +184,24 @@ namespace ra { namespace test {
     ASSERT_EQ(foundLineNumber, actualLineNumber);
   }
 
+  TEST_F(TestGTestHelp, testGetTextFileContentStringList)
+  {
+    ra::strings::StringVector expectedLines;
+    bool success = ra::gtesthelp::getTextFileContent( __FILE__, expectedLines );
+    ASSERT_TRUE(success);
+
+    ra::strings::StringList lines;
+    success = ra::gtesthelp::getTextFileContent( __FILE__, lines );
+    ASSERT_TRUE(success);
+    ASSERT_EQ(expectedLines.size(), lines.size());
+    for(size_t i=0; i<lines.size(); i++)
+    {
+      ASSERT_EQ(expectedLines[i], lines[i].toString());
+      ASSERT_STREQ(expectedLines[i].c_str(), lines.c_str(i));
+    }
+
+    ASSERT_FALSE(ra::gtesthelp::getTextFileContent( "this file does not exists", lines ));
+  }
+
 } //namespace test
 } //namespace ra
@@ -0,0 +1,198 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestHash.h"
+#include "rapidassist/hash.h"
+#include "rapidassist/time_.h"
+
+#include <stdio.h> //for printf()
+#include <vector>
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define TEST_RA_HASH_STD_HASH
+#include <functional> //for std::hash
+#endif
+
+namespace ra { namespace hash { namespace test
+{
+
+  //--------------------------------------------------------------------------------------------------
+  void TestHash::SetUp()
+  {
+  }
+  //--------------------------------------------------------------------------------------------------
+  void TestHash::TearDown()
+  {
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string getSequentialBuffer(size_t iSize)
+  {
+    std::string buffer;
+    buffer.resize(iSize);
+    for(size_t i=0; i<iSize; i++)
+    {
+      buffer[i] = (char)((i * 31 + 7) % 256);
+    }
+    return buffer;
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestHash, testHash64)
+  {
+    //known values
+    ASSERT_EQ(0xEF46DB3751D8E999ull, hash64(""));
+    ASSERT_EQ(0xD24EC4F1A98C6E5Bull, hash64("a"));
+    ASSERT_EQ(0x44BC2CF5AD770999ull, hash64("abc"));
+    ASSERT_EQ(0xFBCEA83C8A378BF1ull, hash64("Nobody inspects the spammish repetition"));
+
+    //buffer and string versions must match
+    std::string value = "The quick brown fox jumps over the lazy dog";
+    ASSERT_EQ(hash64(value), hash64(value.data(), value.size()));
+
+    //seed must change the hash
+    ASSERT_NE(hash64(value.data(), value.size(), 1), hash64(value.data(), value.size(), 2));
+
+    //a single bit difference must change the hash
+    std::string other = value;
+    other[10] ^= 1;
+    ASSERT_NE(hash64(value), hash64(other));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestHash, testHasher64)
+  {
+    const std::string buffer = getSequentialBuffer(1000);
+
+    //all sizes around stripe boundaries, split in all kind of parts
+    static const size_t sizes[] = {0, 1, 3, 4, 7, 8, 31, 32, 33, 63, 64, 65, 100, 1000};
+    static const size_t parts[] = {1, 3, 5, 16, 31, 32, 33, 100};
+    for(size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++)
+    {
+      const size_t size = sizes[i];
+      const uint64_t expected = hash64(buffer.data(), size, 7);
+      for(size_t j=0; j<sizeof(parts)/sizeof(parts[0]); j++)
+      {
+        Hasher64 hasher(7);
+        for(size_t offset = 0; offset < size; offset += parts[j])
+        {
+          size_t count = (size - offset < parts[j] ? size - offset : parts[j]);
+          hasher.update(buffer.data() + offset, count);
+        }
+        ASSERT_EQ(expected, hasher.digest()) << "size=" << size << " part=" << parts[j];
+      }
+    }
+
+    //digest can be called multiple times
+    Hasher64 hasher;
+    hasher.update(std::string("ab"));
+    ASSERT_EQ(hash64("ab"), hasher.digest());
+    hasher.update(std::string("c"));
+    ASSERT_EQ(hash64("abc"), hasher.digest());
+
+    //reset
+    hasher.reset(5);
+    hasher.update(std::string("abc"));
+    ASSERT_EQ(hash64("abc", 3, 5), hasher.digest());
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestHash, testCrc32c)
+  {
+    printf("crc32c() hardware acceleration: %s\n", (isCrc32cAccelerated() ? "yes" : "no"));
+
+    //known values
+    ASSERT_EQ(0xE3069283u, crc32c("123456789"));
+    ASSERT_EQ(0x00000000u, crc32c(""));
+    ASSERT_EQ(0x8A9136AAu, crc32c(std::string(32, '\0')));
+    ASSERT_EQ(0x62A8AB43u, crc32c(std::string(32, '\xFF')));
+
+    //checksum in multiple parts
+    const std::string buffer = getSequentialBuffer(1000);
+    const uint32_t expected = crc32c(buffer);
+    for(size_t part = 1; part < 20; part++)
+    {
+      uint32_t crc = 0;
+      for(size_t offset = 0; offset < buffer.size(); offset += part)
+      {
+        size_t count = (buffer.size() - offset < part ? buffer.size() - offset : part);
+        crc = crc32c(buffer.data() + offset, count, crc);
+      }
+      ASSERT_EQ(expected, crc) << "part=" << part;
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestHash, testHashPerformance)
+  {
+    static const size_t BUFFER_SIZE = 16 * 1024 * 1024;
+    const std::string buffer = getSequentialBuffer(BUFFER_SIZE);
+    const double megabytes = (double)BUFFER_SIZE / (1024.0 * 1024.0);
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    uint64_t hash = hash64(buffer);
+    double timeHash64 = ra::time::getMicrosecondsTimer() - timeStart;
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    uint32_t crc = crc32c(buffer);
+    double timeCrc32c = ra::time::getMicrosecondsTimer() - timeStart;
+
+    printf("hash64(): %.0f MB/s (0x%08X%08X)\n", megabytes / timeHash64, (uint32_t)(hash >> 32), (uint32_t)hash);
+    printf("crc32c(): %.0f MB/s (0x%08X)\n", megabytes / timeCrc32c, crc);
+
+#ifdef TEST_RA_HASH_STD_HASH
+    timeStart = ra::time::getMicrosecondsTimer();
+    size_t stdHash = std::hash<std::string>()(buffer);
+    double timeStdHash = ra::time::getMicrosecondsTimer() - timeStart;
+    printf("std::hash: %.0f MB/s (%lu)\n", megabytes / timeStdHash, (unsigned long)stdHash);
+#endif
+
+    //short keys such as file paths
+    static const size_t NUM_KEYS = 100000;
+    std::vector<std::string> keys;
+    for(size_t i=0; i<NUM_KEYS; i++)
+    {
+      char key[64];
+      sprintf(key, "/home/user/project/src/module%d/file%d.cpp", (int)(i % 97), (int)i);
+      keys.push_back(key);
+    }
+
+    uint64_t sum = 0;
+    timeStart = ra::time::getMicrosecondsTimer();
+    for(size_t i=0; i<NUM_KEYS; i++)
+    {
+      sum += hash64(keys[i]);
+    }
+    double timeKeys = ra::time::getMicrosecondsTimer() - timeStart;
+    printf("hash64() of %d paths: %.3f ms (%u)\n", (int)NUM_KEYS, timeKeys * 1000.0, (uint32_t)sum);
+
+#ifdef TEST_RA_HASH_STD_HASH
+    sum = 0;
+    timeStart = ra::time::getMicrosecondsTimer();
+    for(size_t i=0; i<NUM_KEYS; i++)
+    {
+      sum += std::hash<std::string>()(keys[i]);
+    }
+    timeKeys = ra::time::getMicrosecondsTimer() - timeStart;
+    printf("std::hash of %d paths: %.3f ms (%u)\n", (int)NUM_KEYS, timeKeys * 1000.0, (uint32_t)sum);
+#endif
+  }
+  //--------------------------------------------------------------------------------------------------
+} //namespace test
+} //namespace hash
+} //namespace ra
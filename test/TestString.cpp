@@ -25,6 +25,25 @@
 #include "TestString.h"
 #include "rapidassist/strings.h"
 #include "rapidassist/environment.h"
+#include "rapidassist/time_.h"
+
+#include <sstream>  //for std::stringstream
+#include <stdlib.h> //for strtod()
+#include <limits>   //for std::numeric_limits
+#include <locale.h> //for setlocale()
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
+#endif /* WIN32_LEAN_AND_MEAN */
+#ifndef NOMINMAX
+#define NOMINMAX // for std::numeric_limits<T>::max()
+#endif /* NOMINMAX */
+#include <process.h> //for _beginthreadex()
+#include <Windows.h>
+#else
+#include <pthread.h>
+#endif
 
 namespace ra { namespace strings { namespace test
 {
@@ -38,6 +57,18 @@ namespace ra { namespace strings { namespace test
   {
   }
   //--------------------------------------------------------------------------------------------------
+  //Reference backtracking implementation used for validating GlobMatcher.
+  bool referenceGlobMatch(const char * iPattern, const char * iValue)
+  {
+    if (*iPattern == '\0')
+      return *iValue == '\0';
+    if (*iPattern == '*')
+      return referenceGlobMatch(iPattern + 1, iValue) || (*iValue != '\0' && referenceGlobMatch(iPattern, iValue + 1));
+    if (*iValue != '\0' && (*iPattern == '?' || *iPattern == *iValue))
+      return referenceGlobMatch(iPattern + 1, iValue + 1);
+    return false;
+  }
+  //--------------------------------------------------------------------------------------------------
   TEST_F(TestString, testIsNumeric)
   {
     //lazy test
@@ -75,6 +106,81 @@ namespace ra { namespace strings { namespace test
     //alpha characters
     ASSERT_FALSE(strings::isNumeric("+12.34a"));
     ASSERT_FALSE(strings::isNumeric("+12.34!"));
+
+    //at least one digit is required
+    ASSERT_FALSE(strings::isNumeric(""));
+    ASSERT_FALSE(strings::isNumeric("+"));
+    ASSERT_FALSE(strings::isNumeric("-."));
+    ASSERT_TRUE(strings::isNumeric(".5"));
+    ASSERT_TRUE(strings::isNumeric("5."));
+    ASSERT_FALSE(strings::isNumeric(NULL));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testIsNumericLength)
+  {
+    //values are not required to be NULL terminated
+    static const char * buffer = "12345abc";
+    ASSERT_TRUE(strings::isNumeric(StringRef(buffer, 5), false));
+    ASSERT_FALSE(strings::isNumeric(StringRef(buffer, 6), false));
+
+    //long values crossing multiple 16 bytes blocks
+    std::string value = "-";
+    value.append(40, '7');
+    value.append(".");
+    value.append(37, '3');
+    ASSERT_TRUE(strings::isNumeric(value, false));
+    for(size_t i=1; i<value.size(); i++)
+    {
+      if (value[i] == '.')
+        continue;
+      std::string invalid = value;
+      invalid[i] = 'x';
+      ASSERT_FALSE(strings::isNumeric(invalid, false)) << "isNumeric(\"" << invalid << "\") returned true.";
+    }
+
+    //scientific notation
+    ASSERT_TRUE(strings::isNumeric("1.5e-3", true));
+    ASSERT_TRUE(strings::isNumeric("-1E+10", true));
+    ASSERT_TRUE(strings::isNumeric(".5e3", true));
+    ASSERT_FALSE(strings::isNumeric("1.5e-3", false));
+    ASSERT_FALSE(strings::isNumeric("1.5e", true));
+    ASSERT_FALSE(strings::isNumeric("1.5e+", true));
+    ASSERT_FALSE(strings::isNumeric("e5", true));
+    ASSERT_FALSE(strings::isNumeric("1e5.0", true));
+    ASSERT_FALSE(strings::isNumeric("1e5e5", true));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testIsNumericBatch)
+  {
+    static const char * values[] = {"1", "abc", "-2.5", "", "3e5", "+", "42", "7.", "x1", ".9", "1-1"};
+    static const size_t count = sizeof(values)/sizeof(values[0]);
+
+    StringRefVector column;
+    for(size_t i=0; i<count; i++)
+    {
+      column.push_back(values[i]);
+    }
+
+    uint8_t bitmap[2] = {0xFF, 0xFF};
+    size_t numNumeric = strings::isNumericBatch(&column[0], column.size(), bitmap, false);
+    ASSERT_EQ((size_t)5, numNumeric);
+    ASSERT_EQ(0xC5, bitmap[0]); //bits 0, 2, 6, 7
+    ASSERT_EQ(0x02, bitmap[1]); //bit 9
+
+    numNumeric = strings::isNumericBatch(&column[0], column.size(), bitmap, true);
+    ASSERT_EQ((size_t)6, numNumeric);
+    ASSERT_EQ(0xD5, bitmap[0]); //bits 0, 2, 4, 6, 7
+
+    //results must match the single value function
+    for(size_t i=0; i<count; i++)
+    {
+      bool expected = strings::isNumeric(values[i]);
+      bool actual = ((bitmap[i / 8] >> (i % 8)) & 1) != 0;
+      if (i != 4) //scientific notation
+      {
+        ASSERT_EQ(expected, actual) << "value " << values[i];
+      }
+    }
   }
   //--------------------------------------------------------------------------------------------------
   TEST_F(TestString, testStrReplace)
@@ -134,6 +240,99 @@ namespace ra { namespace strings { namespace test
     }
   }
   //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testStrReplaceOutput)
+  {
+    //replace short string by longer string
+    {
+      const std::string EXPECTED = "super deadbeef super dead";
+      const std::string str = "deadbeef dead";
+      std::string output;
+      int numReplacements = strReplace(output, str, "dead", "super dead");
+      ASSERT_EQ(2, numReplacements);
+      ASSERT_EQ(EXPECTED, output);
+    }
+
+    //replace nothing
+    {
+      const std::string str = "deadbeef";
+      std::string output = "garbage";
+      int numReplacements = strReplace(output, str, "notfound", "error");
+      ASSERT_EQ(0, numReplacements);
+      ASSERT_EQ(str, output);
+    }
+
+    //test large input
+    {
+      std::string str;
+      std::string expected;
+      for(size_t i=0; i<10000; i++)
+      {
+        str.append("a\\b");
+        expected.append("a/b");
+      }
+      int numReplacements = strReplace(str, "\\", "/");
+      ASSERT_EQ(10000, numReplacements);
+      ASSERT_EQ(expected, str);
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testStrReplaceMultiple)
+  {
+    StringVector oldValues;
+    StringVector newValues;
+    oldValues.push_back("{name}");      newValues.push_back("Antoine");
+    oldValues.push_back("{hero}");      newValues.push_back("superhero");
+    oldValues.push_back("{hero}ine");   newValues.push_back("superheroine");
+    oldValues.push_back("{");           newValues.push_back("<");
+
+    //test longest match wins
+    {
+      const std::string EXPECTED = "My name is Antoine and I am a superheroine <not a villain}.";
+      std::string str = "My name is {name} and I am a {hero}ine {not a villain}.";
+      int numReplacements = strReplace(str, oldValues, newValues);
+      ASSERT_EQ(3, numReplacements);
+      ASSERT_EQ(EXPECTED, str);
+    }
+
+    //test replacements are not replaced again
+    {
+      StringReplacer replacer;
+      replacer.add("a", "b");
+      replacer.add("b", "a");
+      std::string output;
+      int numReplacements = replacer.replace(output, "aabbc");
+      ASSERT_EQ(4, numReplacements);
+      ASSERT_EQ("bbaac", output);
+    }
+
+    //test no replacements
+    {
+      StringReplacer replacer;
+      std::string str = "deadbeef";
+      ASSERT_EQ(0, replacer.replace(str));
+      ASSERT_EQ("deadbeef", str);
+    }
+
+    //test values using new characters after the trie is built
+    {
+      StringReplacer replacer;
+      replacer.add("ab", "1");
+      replacer.add("abc", "2");
+      replacer.add(StringRef("a\0\xff", 3), "3");
+      replacer.add("z", "4");
+      std::string output;
+      int numReplacements = replacer.replace(output, StringRef("xabyabcza\0\xff\xff", 12));
+      ASSERT_EQ(4, numReplacements);
+      ASSERT_EQ(std::string("x1y243\xff"), output);
+
+      replacer.clear();
+      replacer.add("y", "Y");
+      numReplacements = replacer.replace(output, "xabyz");
+      ASSERT_EQ(1, numReplacements);
+      ASSERT_EQ(std::string("xabYz"), output);
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
   TEST_F(TestString, testToStringParseValue)
   {
     //uint64_t
@@ -165,6 +364,322 @@ namespace ra { namespace strings { namespace test
       ASSERT_TRUE(parsed);
       ASSERT_EQ(EXPECTED_VALUE, actualValue);
     }
+
+    //assert invalid values
+    uint64_t value = 0;
+    ASSERT_FALSE(parseValue("", value));
+    ASSERT_FALSE(parseValue("12-34", value));
+    ASSERT_FALSE(parseValue("-1234", value));
+    ASSERT_FALSE(parseValue("1234abc", value));
+    ASSERT_FALSE(parseValue("18446744073709551616", value)); //overflow
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testFromChars)
+  {
+    //test all integer types limits
+    {
+      const std::string str = "-128";
+      int8_t value = 0;
+      FROMCHARS_RESULT result = fromChars(str.c_str(), str.c_str() + str.size(), value);
+      ASSERT_EQ(FROMCHARS_SUCCESS, result.error);
+      ASSERT_EQ(str.c_str() + str.size(), result.ptr);
+      ASSERT_EQ(-128, value);
+    }
+    {
+      const std::string str = "-129";
+      int8_t value = 5;
+      FROMCHARS_RESULT result = fromChars(str.c_str(), str.c_str() + str.size(), value);
+      ASSERT_EQ(FROMCHARS_OUT_OF_RANGE, result.error);
+      ASSERT_EQ(5, value); //unmodified
+    }
+    {
+      const std::string str = "65535";
+      uint16_t value = 0;
+      ASSERT_EQ(FROMCHARS_SUCCESS, fromChars(str.c_str(), str.c_str() + str.size(), value).error);
+      ASSERT_EQ(65535, value);
+    }
+    {
+      const std::string str = "-2147483648";
+      int32_t value = 0;
+      ASSERT_EQ(FROMCHARS_SUCCESS, fromChars(str.c_str(), str.c_str() + str.size(), value).error);
+      ASSERT_EQ(-2147483647l-1, value);
+    }
+    {
+      const std::string str = "2147483648";
+      int32_t value = 0;
+      ASSERT_EQ(FROMCHARS_OUT_OF_RANGE, fromChars(str.c_str(), str.c_str() + str.size(), value).error);
+    }
+    {
+      const std::string str = "-9223372036854775808";
+      int64_t value = 0;
+      ASSERT_EQ(FROMCHARS_SUCCESS, fromChars(str.c_str(), str.c_str() + str.size(), value).error);
+      ASSERT_EQ(-9223372036854775807ll-1, value);
+    }
+    {
+      const std::string str = "18446744073709551615";
+      uint64_t value = 0;
+      ASSERT_EQ(FROMCHARS_SUCCESS, fromChars(str.c_str(), str.c_str() + str.size(), value).error);
+      ASSERT_EQ(18446744073709551615ull, value);
+    }
+    {
+      //overflow consumes all digits
+      const std::string str = "123456789012345678901234567890,";
+      uint64_t value = 0;
+      FROMCHARS_RESULT result = fromChars(str.c_str(), str.c_str() + str.size(), value);
+      ASSERT_EQ(FROMCHARS_OUT_OF_RANGE, result.error);
+      ASSERT_EQ(',', *result.ptr);
+    }
+
+    //test trailing characters
+    {
+      const std::string str = "1234,5678";
+      uint32_t value = 0;
+      FROMCHARS_RESULT result = fromChars(str.c_str(), str.c_str() + str.size(), value);
+      ASSERT_EQ(FROMCHARS_SUCCESS, result.error);
+      ASSERT_EQ(1234, value);
+      ASSERT_EQ(',', *result.ptr);
+    }
+
+    //test invalid arguments
+    {
+      static const char * inputs[] = {"", "-", "abc", " 12", "+12"};
+      static const size_t numInputs = sizeof(inputs)/sizeof(inputs[0]);
+      for(size_t i=0; i<numInputs; i++)
+      {
+        const char * str = inputs[i];
+        int32_t value = 0;
+        FROMCHARS_RESULT result = fromChars(str, str + strlen(str), value);
+        ASSERT_EQ(FROMCHARS_INVALID_ARGUMENT, result.error) << "str=" << str;
+        ASSERT_EQ(str, result.ptr);
+      }
+
+      //sign is not accepted for unsigned types
+      const std::string str = "-12";
+      uint32_t value = 0;
+      ASSERT_EQ(FROMCHARS_INVALID_ARGUMENT, fromChars(str.c_str(), str.c_str() + str.size(), value).error);
+    }
+
+    //test hexadecimal
+    {
+      const std::string str = "DeadBeef";
+      uint32_t value = 0;
+      ASSERT_EQ(FROMCHARS_SUCCESS, fromChars(str.c_str(), str.c_str() + str.size(), value, 16).error);
+      ASSERT_EQ(0xDEADBEEF, value);
+    }
+
+    //test all values of a long digit sequence
+    for(uint64_t value = 1; value < 10000000000000000000ull; value = value*3+7)
+    {
+      char buffer[TOCHARS_BUFFER_SIZE];
+      size_t length = toChars(buffer, value);
+      uint64_t actual = 0;
+      FROMCHARS_RESULT result = fromChars(buffer, buffer + length, actual);
+      ASSERT_EQ(FROMCHARS_SUCCESS, result.error);
+      ASSERT_EQ(value, actual);
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testFromCharsDouble)
+  {
+    static const char * inputs[] = {
+      "0", "-0", "1", "-1.5", "3.14159", ".5", "1.", "1e10", "1E-10", "-2.5e+3",
+      "0.1", "0.30000000000000004", "123456789012345678901234567890",
+      "1.7976931348623157e308", "4.9406564584124654e-324", "2.2250738585072014e-308",
+      "0.000000000000000000000000000001", "9007199254740993",
+    };
+    static const size_t numInputs = sizeof(inputs)/sizeof(inputs[0]);
+    for(size_t i=0; i<numInputs; i++)
+    {
+      const char * str = inputs[i];
+      const char * last = str + strlen(str);
+      double value = 0.0;
+      FROMCHARS_RESULT result = fromChars(str, last, value);
+      ASSERT_EQ(FROMCHARS_SUCCESS, result.error) << "str=" << str;
+      ASSERT_EQ(last, result.ptr) << "str=" << str;
+      ASSERT_EQ(strtod(str, NULL), value) << "str=" << str;
+    }
+
+    //test partial parsing
+    {
+      const std::string str = "12.5e";
+      double value = 0.0;
+      FROMCHARS_RESULT result = fromChars(str.c_str(), str.c_str() + str.size(), value);
+      ASSERT_EQ(FROMCHARS_SUCCESS, result.error);
+      ASSERT_EQ(12.5, value);
+      ASSERT_EQ('e', *result.ptr);
+    }
+
+    //test special values
+    {
+      const std::string str = "-inf";
+      double value = 0.0;
+      ASSERT_EQ(FROMCHARS_SUCCESS, fromChars(str.c_str(), str.c_str() + str.size(), value).error);
+      ASSERT_EQ(-std::numeric_limits<double>::infinity(), value);
+    }
+
+    //test out of range
+    {
+      const std::string str = "1e400";
+      double value = 0.0;
+      ASSERT_EQ(FROMCHARS_OUT_OF_RANGE, fromChars(str.c_str(), str.c_str() + str.size(), value).error);
+
+      const std::string str2 = "1e39";
+      float value2 = 0.0f;
+      ASSERT_EQ(FROMCHARS_OUT_OF_RANGE, fromChars(str2.c_str(), str2.c_str() + str2.size(), value2).error);
+    }
+
+    //test invalid
+    {
+      const std::string str = "-.e5";
+      double value = 0.0;
+      FROMCHARS_RESULT result = fromChars(str.c_str(), str.c_str() + str.size(), value);
+      ASSERT_EQ(FROMCHARS_INVALID_ARGUMENT, result.error);
+      ASSERT_EQ(str.c_str(), result.ptr);
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testFromCharsFloat)
+  {
+    static const char * inputs[] = {
+      "0", "-0", "1", "-1.5", "0.1", "3.14159", "1e10", "16777216", "16777217",
+      "1.0000000596046447753906250000000001", "1.00000005960464477539062",
+      "3.4028235e38", "1.17549435e-38", "1e-45", "123456789012345678901234567890",
+    };
+    static const size_t numInputs = sizeof(inputs)/sizeof(inputs[0]);
+    for(size_t i=0; i<numInputs; i++)
+    {
+      const char * str = inputs[i];
+      const char * last = str + strlen(str);
+      float value = 0.0f;
+      FROMCHARS_RESULT result = fromChars(str, last, value);
+      ASSERT_EQ(FROMCHARS_SUCCESS, result.error) << "str=" << str;
+      ASSERT_EQ(last, result.ptr) << "str=" << str;
+      ASSERT_EQ(strtof(str, NULL), value) << "str=" << str;
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testToChars)
+  {
+    char buffer[TOCHARS_BUFFER_SIZE];
+
+    //integers limits
+    ASSERT_EQ(4, toChars(buffer, (int8_t)-128));                 ASSERT_STREQ("-128", buffer);
+    ASSERT_EQ(3, toChars(buffer, (uint8_t)255));                 ASSERT_STREQ("255", buffer);
+    ASSERT_EQ(6, toChars(buffer, (int16_t)-32768));              ASSERT_STREQ("-32768", buffer);
+    ASSERT_EQ(5, toChars(buffer, (uint16_t)65535));              ASSERT_STREQ("65535", buffer);
+    ASSERT_EQ(11, toChars(buffer, (int32_t)(-2147483647l-1)));   ASSERT_STREQ("-2147483648", buffer);
+    ASSERT_EQ(10, toChars(buffer, (uint32_t)4294967295ul));      ASSERT_STREQ("4294967295", buffer);
+    ASSERT_EQ(20, toChars(buffer, (int64_t)(-9223372036854775807ll-1))); ASSERT_STREQ("-9223372036854775808", buffer);
+    ASSERT_EQ(20, toChars(buffer, (uint64_t)18446744073709551615ull));    ASSERT_STREQ("18446744073709551615", buffer);
+    ASSERT_EQ(1, toChars(buffer, (uint64_t)0));                  ASSERT_STREQ("0", buffer);
+    ASSERT_EQ(1, toChars(buffer, (int32_t)7));                   ASSERT_STREQ("7", buffer);
+    ASSERT_EQ(2, toChars(buffer, (int32_t)42));                  ASSERT_STREQ("42", buffer);
+    ASSERT_EQ(3, toChars(buffer, (int32_t)-42));                 ASSERT_STREQ("-42", buffer);
+
+    //floating point uses the shortest representation
+    toChars(buffer, 0.1);           ASSERT_STREQ("0.1", buffer);
+    toChars(buffer, -2.5);          ASSERT_STREQ("-2.5", buffer);
+    toChars(buffer, 1e300);         ASSERT_STREQ("1e+300", buffer);
+    toChars(buffer, 0.1f);          ASSERT_STREQ("0.1", buffer);
+    toChars(buffer, 16777216.0f);   ASSERT_STREQ("16777216", buffer);
+
+    //floating point round trip
+    double value = 1.0;
+    for(int i=0; i<1000; i++)
+    {
+      value = value * 1.37 + 0.001;
+      toChars(buffer, value);
+      ASSERT_EQ(value, strtod(buffer, NULL)) << "buffer=" << buffer;
+
+      double inverse = 1.0 / value;
+      toChars(buffer, inverse);
+      ASSERT_EQ(inverse, strtod(buffer, NULL)) << "buffer=" << buffer;
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  bool setCommaDecimalPointLocale()
+  {
+    static const char * LOCALES[] = {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German", "French"};
+    for(size_t i=0; i<sizeof(LOCALES)/sizeof(LOCALES[0]); i++)
+    {
+      if (setlocale(LC_NUMERIC, LOCALES[i]) != NULL && localeconv()->decimal_point[0] == ',')
+        return true;
+    }
+    return false;
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testToCharsLocale)
+  {
+    const std::string previousLocale = setlocale(LC_NUMERIC, NULL);
+    if (!setCommaDecimalPointLocale())
+    {
+      printf("Skipping test. No locale with a ',' decimal point is installed.\n");
+      return;
+    }
+
+    char buffer[TOCHARS_BUFFER_SIZE];
+    toChars(buffer, -2.5);
+    std::string negative = buffer;
+    toChars(buffer, 0.1f);
+    std::string single = buffer;
+    setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    ASSERT_EQ(std::string("-2.5"), negative);
+    ASSERT_EQ(std::string("0.1"), single);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testFromCharsLocale)
+  {
+    const std::string previousLocale = setlocale(LC_NUMERIC, NULL);
+    if (!setCommaDecimalPointLocale())
+    {
+      printf("Skipping test. No locale with a ',' decimal point is installed.\n");
+      return;
+    }
+
+    //the slow path uses the c runtime
+    const std::string str = "0.1000000000000000000000001";
+    double value = 0.0;
+    FROMCHARS_RESULT result = fromChars(str.c_str(), str.c_str() + str.size(), value);
+    float value2 = 0.0f;
+    FROMCHARS_RESULT result2 = fromChars(str.c_str(), str.c_str() + str.size(), value2);
+    setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    ASSERT_EQ(FROMCHARS_SUCCESS, result.error);
+    ASSERT_EQ(str.c_str() + str.size(), result.ptr);
+    ASSERT_EQ(0.1, value);
+    ASSERT_EQ(FROMCHARS_SUCCESS, result2.error);
+    ASSERT_EQ(0.1f, value2);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testToCharsPerformance)
+  {
+    static const uint32_t NUM_VALUES = 200000;
+
+    //benchmark std::stringstream
+    double time1 = ra::time::getMicrosecondsTimer();
+    std::string expected;
+    for(uint32_t i=0; i<NUM_VALUES; i++)
+    {
+      std::stringstream out;
+      out << (i*2654435761u);
+      expected.append(out.str());
+    }
+    double time2 = ra::time::getMicrosecondsTimer();
+
+    //benchmark toChars()
+    std::string actual;
+    for(uint32_t i=0; i<NUM_VALUES; i++)
+    {
+      actual << (uint32_t)(i*2654435761u);
+    }
+    double time3 = ra::time::getMicrosecondsTimer();
+
+    double streamTime = (time2 - time1)*1000.0;
+    double toCharsTime = (time3 - time2)*1000.0;
+    printf("std::stringstream: %f milliseconds, toChars(): %f milliseconds\n", streamTime, toCharsTime);
+
+    ASSERT_EQ(expected, actual);
   }
   //--------------------------------------------------------------------------------------------------
   TEST_F(TestString, testCapitalizeFirstCharacter)
@@ -305,6 +820,70 @@ namespace ra { namespace strings { namespace test
     }
   }
   //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testCaseConversionBuffers)
+  {
+    //build a buffer with all possible characters, longer than a vector register
+    std::string value;
+    for(int i=0; i<3*256; i++)
+    {
+      value.append(1, (char)(i%256));
+    }
+
+    std::string expectedUpper = value;
+    std::string expectedLower = value;
+    for(size_t i=0; i<value.size(); i++)
+    {
+      char c = value[i];
+      if (c >= 'a' && c <= 'z')
+        expectedUpper[i] = (char)(c - 32);
+      if (c >= 'A' && c <= 'Z')
+        expectedLower[i] = (char)(c + 32);
+    }
+
+    //out of place
+    std::string actual(value.size(), '\0');
+    ra::strings::uppercase(&actual[0], value.data(), value.size());
+    ASSERT_EQ(expectedUpper, actual);
+    ra::strings::lowercase(&actual[0], value.data(), value.size());
+    ASSERT_EQ(expectedLower, actual);
+
+    //in place
+    actual = value;
+    uppercaseInPlace(actual);
+    ASSERT_EQ(expectedUpper, actual);
+    lowercaseInPlace(actual);
+    ASSERT_EQ(expectedLower, actual);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testIgnoreCase)
+  {
+    //equals
+    ASSERT_TRUE(equalsIgnoreCase("Content-Type", "content-type"));
+    ASSERT_TRUE(equalsIgnoreCase("", ""));
+    ASSERT_FALSE(equalsIgnoreCase("Content-Type", "content-typ"));
+    ASSERT_FALSE(equalsIgnoreCase("@", "`")); //differs by 0x20 but not letters
+    ASSERT_TRUE(equalsIgnoreCase("The Quick Brown Fox Jumps Over The Lazy Dog", "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG"));
+    ASSERT_FALSE(equalsIgnoreCase("The Quick Brown Fox Jumps Over The Lazy Dog", "THE QUICK BROWN FOX JUMPS OVER THE LAZY CAT"));
+
+    //compare
+    ASSERT_EQ(0, compareIgnoreCase("JPG", "jpg"));
+    ASSERT_LT(compareIgnoreCase("abc", "ABD"), 0);
+    ASSERT_GT(compareIgnoreCase("abd", "ABC"), 0);
+    ASSERT_LT(compareIgnoreCase("abc", "ABCD"), 0);
+    ASSERT_GT(compareIgnoreCase("abcd", "ABC"), 0);
+    ASSERT_LT(compareIgnoreCase("0123456789abcdefghijklmnop", "0123456789ABCDEFGHIJKLMNoQ"), 0);
+
+    //find
+    const std::string text = "The Quick Brown Fox Jumps Over The Lazy Dog";
+    ASSERT_EQ(0, findIgnoreCase(text, "the"));
+    ASSERT_EQ(31, findIgnoreCase(text, "the", 1));
+    ASSERT_EQ(40, findIgnoreCase(text, "DOG"));
+    ASSERT_EQ(16, findIgnoreCase(text, "fOX"));
+    ASSERT_EQ(std::string::npos, findIgnoreCase(text, "cat"));
+    ASSERT_EQ(std::string::npos, findIgnoreCase("abc", "abcd"));
+    ASSERT_EQ(std::string::npos, findIgnoreCase(text, "the", 100));
+  }
+  //--------------------------------------------------------------------------------------------------
   TEST_F(TestString, testStreamOperators)
   {
     {
@@ -489,6 +1068,348 @@ namespace ra { namespace strings { namespace test
     }
   }
   //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testSplitStringRef)
+  {
+    //test multiple characters pattern
+    {
+      static const std::string INPUT = "Aa<>Bb<>Cc";
+      StringRefVector list;
+      splitString(list, INPUT, "<>");
+      ASSERT_EQ(3, list.size());
+      ASSERT_EQ("Aa", list[0].toString());
+      ASSERT_EQ("Bb", list[1].toString());
+      ASSERT_EQ("Cc", list[2].toString());
+
+      //assert tokens are referencing the input buffer
+      ASSERT_EQ(INPUT.data() + 4, list[1].data());
+    }
+
+    //test tokens are identical to splitString()
+    static const char * inputs[] = {
+      "",
+      ".",
+      "..",
+      "Aa",
+      "Aa.",
+      ".Aa",
+      "Aa..Bb",
+      ".Aa..Bb.",
+      "Aa.Bb.Cc",
+    };
+    static const size_t numInputs = sizeof(inputs)/sizeof(inputs[0]);
+    for(size_t i=0; i<numInputs; i++)
+    {
+      const std::string input = inputs[i];
+      StringVector expected = splitString(input, ".");
+      StringRefVector actual;
+      splitString(actual, input, ".");
+      ASSERT_EQ(expected.size(), actual.size()) << "input=\"" << input << "\"";
+      for(size_t j=0; j<expected.size(); j++)
+      {
+        ASSERT_EQ(expected[j], actual[j].toString()) << "input=\"" << input << "\"";
+      }
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testStringTokenizer)
+  {
+    static const std::string INPUT = "The quick brown fox";
+    StringTokenizer tokenizer(INPUT, " ");
+
+    StringRef token;
+    ASSERT_TRUE(tokenizer.next(token)); ASSERT_EQ("The",   token.toString());
+    ASSERT_TRUE(tokenizer.next(token)); ASSERT_EQ("quick", token.toString());
+    ASSERT_TRUE(tokenizer.next(token)); ASSERT_EQ("brown", token.toString());
+    ASSERT_TRUE(tokenizer.next(token)); ASSERT_EQ("fox",   token.toString());
+    ASSERT_FALSE(tokenizer.next(token));
+    ASSERT_FALSE(tokenizer.next(token));
+
+    //test reset
+    tokenizer.reset();
+    ASSERT_TRUE(tokenizer.next(token)); ASSERT_EQ("The",   token.toString());
+
+    //test empty pattern
+    StringTokenizer whole(INPUT, "");
+    ASSERT_TRUE(whole.next(token));
+    ASSERT_EQ(INPUT, token.toString());
+    ASSERT_FALSE(whole.next(token));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testStringList)
+  {
+    StringList list;
+    ASSERT_TRUE(list.empty());
+    ASSERT_TRUE(list.begin() == list.end());
+
+    list.push_back("foo");
+    list.push_back(std::string("bar"));
+    list.push_back("");
+    list.push_back(StringRef("bazinga", 3));
+    ASSERT_EQ((size_t)4, list.size());
+    ASSERT_EQ("foo", list[0].toString());
+    ASSERT_EQ("bar", list[1].toString());
+    ASSERT_TRUE(list[2].empty());
+    ASSERT_EQ("baz", list.back().toString());
+    ASSERT_STREQ("baz", list.c_str(3)); //NULL terminated
+
+    //iteration
+    {
+      StringVector values;
+      for(StringList::const_iterator it = list.begin(); it != list.end(); it++)
+      {
+        values.push_back((*it).toString());
+      }
+      ASSERT_EQ("foo,bar,,baz", joinString(values, ","));
+    }
+
+    //sort
+    list.sort();
+    {
+      StringVector values;
+      list.toStringVector(values);
+      ASSERT_EQ((size_t)4, values.size());
+      ASSERT_EQ("", values[0]);
+      ASSERT_EQ("bar", values[1]);
+      ASSERT_EQ("baz", values[2]);
+      ASSERT_EQ("foo", values[3]);
+    }
+
+    //pop_back
+    list.pop_back();
+    ASSERT_EQ((size_t)3, list.size());
+    ASSERT_EQ("baz", list.back().toString());
+
+    //conversion from a StringVector
+    {
+      StringVector values;
+      values.push_back("a");
+      values.push_back("bb");
+      values.push_back("a");
+      StringList copy(values);
+      ASSERT_EQ((size_t)3, copy.size());
+      ASSERT_TRUE(copy[0] == copy[2]);
+      ASSERT_EQ("bb", copy[1].toString());
+
+      copy.swap(list);
+      ASSERT_EQ("baz", copy.back().toString());
+      ASSERT_EQ("bb", list[1].toString());
+    }
+
+    list.clear();
+    ASSERT_TRUE(list.empty());
+
+    //test adding elements of the list to itself while the buffer grows
+    {
+      StringList self;
+      self.push_back("0123456789");
+      for(size_t i=0; i<1000; i++)
+      {
+        self.push_back(self.back());
+        self.push_back(StringRef(self.c_str(0) + 2, 5));
+      }
+      ASSERT_EQ(2001, self.size());
+      ASSERT_EQ("0123456789", self[0].toString());
+      ASSERT_EQ("0123456789", self[1].toString());
+      for(size_t i=2; i<self.size(); i++)
+      {
+        ASSERT_EQ("23456", self[i].toString()) << "i=" << i;
+      }
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testSplitStringList)
+  {
+    static const char * values[] = {"", "a", ",a", "a,", ",", "a,b,c", ",a,,b,", "abc"};
+    static const size_t count = sizeof(values)/sizeof(values[0]);
+    for(size_t i=0; i<count; i++)
+    {
+      StringVector expected = splitString(values[i], ",");
+      StringList list;
+      splitString(list, values[i], ",");
+      StringVector actual;
+      list.toStringVector(actual);
+      ASSERT_EQ(expected, actual) << "splitString(\"" << values[i] << "\")";
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testStringListPerformance)
+  {
+    static const size_t count = 200000;
+    std::string text;
+    for(size_t i=0; i<count; i++)
+    {
+      if (i > 0)
+        text << ",";
+      text << "element" << (uint32_t)i;
+    }
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    {
+      StringVector vector;
+      splitString(vector, text, ",");
+      ASSERT_EQ(count, vector.size());
+    }
+    double timeVector = ra::time::getMicrosecondsTimer() - timeStart;
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    {
+      StringList list;
+      splitString(list, text, ",");
+      ASSERT_EQ(count, list.size());
+    }
+    double timeList = ra::time::getMicrosecondsTimer() - timeStart;
+
+    printf("split and destroy %d elements: StringVector %.3f ms, StringList %.3f ms\n", (int)count, timeVector * 1000.0, timeList * 1000.0);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testLineTokenizer)
+  {
+    struct LINE_TEST
+    {
+      const char * text;
+      const char * expected; //lines separated by '|'
+      size_t count;
+    };
+    static const LINE_TEST tests[] = {
+      {"",                    "",              0},
+      {"a",                   "a",             1},
+      {"a\n",                 "a",             1},
+      {"a\r\n",               "a",             1},
+      {"a\r",                 "a",             1},
+      {"\n",                  "",              1},
+      {"\n\n",                "|",             2},
+      {"a\nb\r\nc\rd",         "a|b|c|d",       4},
+      {"a\n\r\nb",             "a||b",          3},
+      {"a\r\rb",              "a||b",          3},
+      {"a\n\rb",              "a||b",          3}, //LF CR is two terminators
+      {"abcdefghijklmnopqrstuvwxyz\r\n0123456789012345678901234567890\n", "abcdefghijklmnopqrstuvwxyz|0123456789012345678901234567890", 2},
+    };
+    for(size_t i=0; i<sizeof(tests)/sizeof(tests[0]); i++)
+    {
+      const LINE_TEST & test = tests[i];
+      LineTokenizer tokenizer(test.text);
+      std::string lines;
+      size_t count = 0;
+      StringRef line;
+      while(tokenizer.next(line))
+      {
+        if (count > 0)
+          lines.append("|");
+        lines.append(line.data(), line.size());
+        count++;
+        ASSERT_EQ(count, tokenizer.getLineNumber());
+      }
+      ASSERT_EQ(test.count, count) << "test #" << i;
+      ASSERT_EQ(std::string(test.expected), lines) << "test #" << i;
+
+      //reset
+      tokenizer.reset();
+      ASSERT_EQ(test.count > 0, tokenizer.next(line));
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testLineTokenizerPerformance)
+  {
+    std::string text;
+    for(uint32_t i=0; i<200000; i++)
+    {
+      text << "This is line number " << i << " of the generated text.\r\n";
+    }
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    size_t numLines = 0;
+    size_t numCharacters = 0;
+    LineTokenizer tokenizer(text);
+    StringRef line;
+    while(tokenizer.next(line))
+    {
+      numLines++;
+      numCharacters += line.size();
+    }
+    double timeEnd = ra::time::getMicrosecondsTimer();
+
+    ASSERT_EQ((size_t)200000, numLines);
+    ASSERT_EQ(text.size() - 2 * numLines, numCharacters);
+    printf("LineTokenizer read %d lines in %.3f ms\n", (int)numLines, (timeEnd - timeStart) * 1000.0);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testSplitStringParallel)
+  {
+    //build large texts with runs of separators, leading and trailing separators
+    static const char * patterns[] = {",", "::", "ab", "aa"};
+    for(size_t p=0; p<sizeof(patterns)/sizeof(patterns[0]); p++)
+    {
+      const char * pattern = patterns[p];
+      for(int variant=0; variant<4; variant++)
+      {
+        std::string text;
+        if (variant & 1)
+          text.append(pattern);
+        srand(variant + 1);
+        for(uint32_t i=0; i<60000; i++)
+        {
+          text << "t" << i;
+          int separators = (rand() % 8 == 0 ? 0 : (rand() % 16 == 0 ? 3 : 1));
+          for(int j=0; j<separators; j++)
+            text.append(pattern);
+        }
+        if (variant & 2)
+          text.append(pattern);
+
+        StringRefVector expected;
+        splitString(expected, text, pattern);
+
+        static const size_t threads[] = {0, 1, 2, 3, 7};
+        for(size_t t=0; t<sizeof(threads)/sizeof(threads[0]); t++)
+        {
+          StringRefVector tokens;
+          splitStringParallel(tokens, text, pattern, threads[t]);
+          ASSERT_EQ(expected.size(), tokens.size()) << "pattern=" << pattern << " variant=" << variant << " threads=" << threads[t];
+          for(size_t i=0; i<tokens.size(); i++)
+          {
+            ASSERT_TRUE(expected[i].data() == tokens[i].data() && expected[i].size() == tokens[i].size()) << "token #" << i;
+          }
+        }
+
+        StringVector expectedStrings = splitString(text, pattern);
+        StringVector strings;
+        splitStringParallel(strings, text, pattern, 4);
+        ASSERT_EQ(expectedStrings, strings) << "pattern=" << pattern << " variant=" << variant;
+      }
+    }
+
+    //small texts
+    static const char * values[] = {"", ",", ",,", "a", ",a", "a,", ",a,,b,"};
+    for(size_t i=0; i<sizeof(values)/sizeof(values[0]); i++)
+    {
+      StringVector strings;
+      splitStringParallel(strings, values[i], ",", 4);
+      ASSERT_EQ(splitString(values[i], ","), strings) << "value=" << values[i];
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testSplitStringParallelPerformance)
+  {
+    std::string text;
+    for(uint32_t i=0; i<2000000; i++)
+    {
+      text << "token" << i << ",";
+    }
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    StringRefVector serial;
+    splitString(serial, text, ",");
+    double timeSerial = ra::time::getMicrosecondsTimer() - timeStart;
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    StringRefVector parallel;
+    splitStringParallel(parallel, text, ",", 0);
+    double timeParallel = ra::time::getMicrosecondsTimer() - timeStart;
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    printf("split %d MB: serial %.3f ms, parallel %.3f ms\n", (int)(text.size() / (1024*1024)), timeSerial * 1000.0, timeParallel * 1000.0);
+  }
+  //--------------------------------------------------------------------------------------------------
   TEST_F(TestString, testJoinString)
   {
     //test NULL
@@ -515,6 +1436,267 @@ namespace ra { namespace strings { namespace test
       std::string joinStr = joinString(list, SEPARATOR);
       ASSERT_EQ(EXPECTED, joinStr);
     }
+
+    //test empty elements. No separator before the first non-empty element.
+    {
+      StringVector list;
+      list.push_back("");
+      list.push_back("a");
+      list.push_back("");
+      list.push_back("b");
+      list.push_back("");
+      ASSERT_EQ(std::string("a,,b,"), joinString(list, ","));
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testJoinStringRange)
+  {
+    static const char * values[] = {"Aa", "Bb", "", "Cc"};
+    static const size_t count = sizeof(values)/sizeof(values[0]);
+
+    //array of c strings
+    ASSERT_EQ(std::string("Aa, Bb, , Cc"), joinString(values, values + count, ", "));
+    ASSERT_EQ(std::string(""), joinString(values, values, ", "));
+
+    //views
+    StringRefVector refs(values, values + count);
+    ASSERT_EQ(std::string("Aa-Bb--Cc"), joinString(refs.begin(), refs.end(), "-"));
+
+    //StringList
+    StringList list;
+    for(size_t i=0; i<count; i++)
+    {
+      list.push_back(values[i]);
+    }
+    ASSERT_EQ(std::string("Aa-Bb--Cc"), joinString(list, "-"));
+
+    //all implementations must match
+    static const char * cases[] = {"", ",", "a", ",a", "a,", ",,a,,b,", "a,b,c"};
+    for(size_t i=0; i<sizeof(cases)/sizeof(cases[0]); i++)
+    {
+      StringVector vector = splitString(cases[i], ",");
+      StringList tokens;
+      splitString(tokens, cases[i], ",");
+      ASSERT_EQ(joinString(vector, "+"), joinString(tokens, "+")) << "case " << cases[i];
+      ASSERT_EQ(joinString(vector, "+"), joinString(vector.begin(), vector.end(), "+")) << "case " << cases[i];
+    }
+
+    //append to an existing string
+    {
+      std::string output = "values: ";
+      appendJoinString(output, values, values + 2, ", ");
+      output.append("; more: ");
+      appendJoinString(output, list.begin(), list.end(), "/");
+      ASSERT_EQ(std::string("values: Aa, Bb; more: Aa/Bb//Cc"), output);
+    }
+
+    //large output
+    {
+      StringVector big(1000, "abcdefghij");
+      std::string output;
+      appendJoinString(output, big.begin(), big.end(), ",");
+      ASSERT_EQ((size_t)(1000 * 10 + 999), output.size());
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testGlobMatcher)
+  {
+    ASSERT_TRUE(globMatch("*.txt", "file.txt"));
+    ASSERT_TRUE(globMatch("*.txt", ".txt"));
+    ASSERT_FALSE(globMatch("*.txt", "file.txt.bak"));
+    ASSERT_TRUE(globMatch("file.???", "file.txt"));
+    ASSERT_FALSE(globMatch("file.???", "file.tx"));
+    ASSERT_TRUE(globMatch("a*b*c", "abc"));
+    ASSERT_TRUE(globMatch("a*b*c", "aXbYbZc"));
+    ASSERT_FALSE(globMatch("a*b*c", "aXbYbZ"));
+    ASSERT_TRUE(globMatch("*aab", "aaaab")); //leftmost match of "aab" is not at the end
+    ASSERT_TRUE(globMatch("*", ""));
+    ASSERT_TRUE(globMatch("**", "anything"));
+    ASSERT_TRUE(globMatch("", ""));
+    ASSERT_FALSE(globMatch("", "a"));
+    ASSERT_TRUE(globMatch("abc", "abc"));
+    ASSERT_FALSE(globMatch("abc", "abcd"));
+    ASSERT_FALSE(globMatch("ab*ba", "aba")); //prefix and suffix must not overlap
+    ASSERT_TRUE(globMatch("my-file:*", "my-file:1")); //no special meaning for '-' and ':'
+
+    //compare with a reference implementation
+    static const char * patterns[] = {"", "*", "?", "a*", "*a", "*a*", "a?b", "a*b", "*ab*ba*", "??*?", "a*a*a", "*?a?*", "b*?*b", "ab*", "*b?"};
+    static const char * values[] = {"", "a", "b", "ab", "ba", "aa", "aab", "abab", "abba", "baab", "aaaaa", "abcba", "bab", "abbab", "xaby"};
+    for(size_t i=0; i<sizeof(patterns)/sizeof(patterns[0]); i++)
+    {
+      GlobMatcher matcher(patterns[i]);
+      for(size_t j=0; j<sizeof(values)/sizeof(values[0]); j++)
+      {
+        ASSERT_EQ(referenceGlobMatch(patterns[i], values[j]), matcher.match(values[j])) << "pattern=\"" << patterns[i] << "\" value=\"" << values[j] << "\"";
+      }
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testGlobMatcherFilter)
+  {
+    GlobMatcher matcher;
+    ASSERT_TRUE(matcher.match(""));
+    ASSERT_FALSE(matcher.match("a"));
+
+    //empty filter matches everything
+    matcher.compileFilter("");
+    ASSERT_TRUE(matcher.match("TestFoo.testFoo"));
+
+    //positive patterns
+    matcher.compileFilter("TestFoo.*:TestBar.testBar?");
+    ASSERT_TRUE(matcher.match("TestFoo.testFoo"));
+    ASSERT_TRUE(matcher.match("TestBar.testBar1"));
+    ASSERT_FALSE(matcher.match("TestBar.testBar"));
+    ASSERT_FALSE(matcher.match("TestBaz.testBaz"));
+
+    //negative patterns only
+    matcher.compileFilter("-*.testSlow*:TestBar.*");
+    ASSERT_TRUE(matcher.match("TestFoo.testFoo"));
+    ASSERT_FALSE(matcher.match("TestFoo.testSlowFoo"));
+    ASSERT_FALSE(matcher.match("TestBar.testBar"));
+
+    //positive and negative patterns
+    matcher.compileFilter("TestFoo.*-TestFoo.testB*:*Slow");
+    ASSERT_TRUE(matcher.match("TestFoo.testA"));
+    ASSERT_FALSE(matcher.match("TestFoo.testB"));
+    ASSERT_FALSE(matcher.match("TestFoo.testASlow"));
+    ASSERT_FALSE(matcher.match("TestBar.testA"));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testGlobMatcherPerformance)
+  {
+    static const size_t count = 200000;
+    StringList names;
+    for(size_t i=0; i<count; i++)
+    {
+      std::string name;
+      name << "TestSuite" << (uint32_t)(i % 100) << ".testCase" << (uint32_t)i;
+      names.push_back(name);
+    }
+
+    GlobMatcher matcher;
+    matcher.compileFilter("TestSuite1*.*:*.testCase?-*5:*.testCase1*7");
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    size_t numMatches = 0;
+    for(StringList::const_iterator it = names.begin(); it != names.end(); ++it)
+    {
+      if (matcher.match(*it))
+        numMatches++;
+    }
+    double timeEnd = ra::time::getMicrosecondsTimer();
+
+    ASSERT_GT(numMatches, (size_t)0);
+    printf("GlobMatcher matched %d of %d names in %.3f ms\n", (int)numMatches, (int)count, (timeEnd - timeStart) * 1000.0);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testStringPool)
+  {
+    StringPool pool;
+    ASSERT_EQ((size_t)0, pool.size());
+    ASSERT_EQ(StringPool::INVALID_ID, pool.find("foo"));
+
+    StringPool::ID foo = pool.intern("foo");
+    StringPool::ID bar = pool.intern(std::string("bar"));
+    StringPool::ID empty = pool.intern("");
+    ASSERT_NE(foo, bar);
+    ASSERT_NE(foo, empty);
+    ASSERT_EQ((size_t)3, pool.size());
+
+    //same value, same id
+    ASSERT_EQ(foo, pool.intern(StringRef("foobar", 3)));
+    ASSERT_EQ(bar, pool.find("bar"));
+    ASSERT_EQ(empty, pool.find(""));
+    ASSERT_EQ((size_t)3, pool.size());
+
+    //values
+    ASSERT_EQ("foo", pool.get(foo).toString());
+    ASSERT_STREQ("bar", pool.get(bar).data()); //NULL terminated
+    ASSERT_TRUE(pool.get(empty).empty());
+    ASSERT_TRUE(pool.get(StringPool::INVALID_ID).empty());
+
+    //references are stable while the pool grows
+    const char * fooAddress = pool.get(foo).data();
+    std::string large(100000, 'x');
+    StringPool::ID largeId = pool.intern(large);
+    for(uint32_t i=0; i<10000; i++)
+    {
+      std::string value;
+      value << "/home/user/folder" << (i % 10) << "/file" << i << ".txt";
+      pool.intern(value);
+    }
+    ASSERT_EQ((size_t)(4 + 10000), pool.size());
+    ASSERT_EQ(fooAddress, pool.get(foo).data());
+    ASSERT_EQ(large, pool.get(largeId).toString());
+    ASSERT_EQ(std::string("/home/user/folder3/file1233.txt"), pool.get(pool.find("/home/user/folder3/file1233.txt")).toString());
+
+    pool.clear();
+    ASSERT_EQ((size_t)0, pool.size());
+    ASSERT_EQ(StringPool::INVALID_ID, pool.find("foo"));
+  }
+  //--------------------------------------------------------------------------------------------------
+  struct POOL_THREAD_DATA
+  {
+    StringPool * pool;
+    std::vector<StringPool::ID> ids;
+  };
+#ifdef _WIN32
+  unsigned __stdcall internStrings(void * iData)
+#else
+  void * internStrings(void * iData)
+#endif
+  {
+    POOL_THREAD_DATA * data = (POOL_THREAD_DATA *)iData;
+    for(uint32_t i=0; i<5000; i++)
+    {
+      std::string value;
+      value << "value" << i;
+      data->ids.push_back(data->pool->intern(value));
+    }
+    return 0;
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testStringPoolThreads)
+  {
+    static const size_t NUM_THREADS = 4;
+    StringPool pool;
+    POOL_THREAD_DATA data[NUM_THREADS];
+
+    //all threads intern the same values concurrently
+#ifdef _WIN32
+    HANDLE threads[NUM_THREADS];
+    for(size_t i=0; i<NUM_THREADS; i++)
+    {
+      data[i].pool = &pool;
+      threads[i] = (HANDLE)_beginthreadex(NULL, 0, &internStrings, &data[i], 0, NULL);
+      ASSERT_TRUE(threads[i] != NULL);
+    }
+    WaitForMultipleObjects(NUM_THREADS, threads, TRUE, INFINITE);
+    for(size_t i=0; i<NUM_THREADS; i++)
+      CloseHandle(threads[i]);
+#else
+    pthread_t threads[NUM_THREADS];
+    for(size_t i=0; i<NUM_THREADS; i++)
+    {
+      data[i].pool = &pool;
+      ASSERT_EQ(0, pthread_create(&threads[i], NULL, &internStrings, &data[i]));
+    }
+    for(size_t i=0; i<NUM_THREADS; i++)
+      pthread_join(threads[i], NULL);
+#endif
+
+    //each value must have a single id
+    ASSERT_EQ((size_t)5000, pool.size());
+    for(size_t i=1; i<NUM_THREADS; i++)
+    {
+      ASSERT_EQ(data[0].ids, data[i].ids);
+    }
+    for(uint32_t i=0; i<5000; i++)
+    {
+      std::string value;
+      value << "value" << i;
+      ASSERT_EQ(value, pool.get(data[0].ids[i]).toString());
+    }
   }
   //--------------------------------------------------------------------------------------------------
   TEST_F(TestString, testTrim)
@@ -534,6 +1716,111 @@ namespace ra { namespace strings { namespace test
     }
 
     ASSERT_EQ("", trim(""));
+    ASSERT_EQ("", trim("     "));
+    ASSERT_EQ("a b", trim(" a b "));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testTrimRef)
+  {
+    {
+      static const std::string value = "***abc***";
+      StringRef ref = trimRef(value, '*');
+      ASSERT_EQ("abc", ref.toString());
+      ASSERT_EQ(value.data() + 3, ref.data()); //no copy
+      ASSERT_EQ("abc***", trimLeftRef(value, '*').toString());
+      ASSERT_EQ("***abc", trimRightRef(value, '*').toString());
+    }
+
+    {
+      static const std::string value = " \t\r\nabc def\r\n\t ";
+      static const char * whitespaces = " \t\r\n";
+      ASSERT_EQ("abc def", trimRef(value, whitespaces).toString());
+      ASSERT_EQ("abc def\r\n\t ", trimLeftRef(value, whitespaces).toString());
+      ASSERT_EQ(" \t\r\nabc def", trimRightRef(value, whitespaces).toString());
+    }
+
+    //nothing to trim
+    ASSERT_EQ("abc", trimRef("abc", " \t").toString());
+    ASSERT_EQ("abc", trimRef("abc", "").toString());
+
+    //everything trimmed
+    ASSERT_TRUE(trimRef("\t \t", " \t").empty());
+    ASSERT_TRUE(trimLeftRef("****", '*').empty());
+    ASSERT_TRUE(trimRightRef("****", '*').empty());
+    ASSERT_TRUE(trimRef("", '*').empty());
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testTrimInPlace)
+  {
+    {
+      std::string value = "***abc***";
+      trimInPlace(value, '*');
+      ASSERT_EQ("abc", value);
+    }
+    {
+      std::string value = "***abc***";
+      trimLeftInPlace(value, '*');
+      ASSERT_EQ("abc***", value);
+    }
+    {
+      std::string value = "***abc***";
+      trimRightInPlace(value, '*');
+      ASSERT_EQ("***abc", value);
+    }
+    {
+      std::string value = "\t\r\n abc \r\n";
+      trimInPlace(value, " \t\r\n");
+      ASSERT_EQ("abc", value);
+    }
+    {
+      std::string value = "\t\r\n abc \r\n";
+      trimLeftInPlace(value, " \t\r\n");
+      ASSERT_EQ("abc \r\n", value);
+    }
+    {
+      std::string value = "\t\r\n abc \r\n";
+      trimRightInPlace(value, " \t\r\n");
+      ASSERT_EQ("\t\r\n abc", value);
+    }
+    {
+      std::string value = "     ";
+      trimInPlace(value, ' ');
+      ASSERT_EQ("", value);
+    }
+
+    //a NULL character does not trim anything, like trim()
+    {
+      const std::string value("\0abc\0", 5);
+      std::string inPlace = value;
+      trimInPlace(inPlace, '\0');
+      ASSERT_EQ(value, inPlace);
+      ASSERT_EQ(trim(value, '\0'), inPlace);
+      inPlace = value;
+      trimLeftInPlace(inPlace, '\0');
+      ASSERT_EQ(trimLeft(value, '\0'), inPlace);
+      inPlace = value;
+      trimRightInPlace(inPlace, '\0');
+      ASSERT_EQ(trimRight(value, '\0'), inPlace);
+      ASSERT_EQ(value.size(), trimRef(value, '\0').size());
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testTrimPerformance)
+  {
+    //a long run of leading characters used to be removed one character at a time
+    std::string value;
+    value.append(200000, ' ');
+    value.append("abc");
+    value.append(200000, ' ');
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    std::string trimmed = trim(value);
+    std::string left = trimLeft(value);
+    double timeEnd = ra::time::getMicrosecondsTimer();
+
+    ASSERT_EQ("abc", trimmed);
+    ASSERT_EQ((size_t)200003, left.size());
+    printf("trim() and trimLeft() of %d characters: %.3f ms\n", (int)value.size(), (timeEnd - timeStart) * 1000.0);
   }
   //--------------------------------------------------------------------------------------------------
   TEST_F(TestString, testReverse)
@@ -551,6 +1838,118 @@ namespace ra { namespace strings { namespace test
   {
     std::string text = ra::strings::format("%d %s %c %3.2f", 23, "this is a string", 'e', 4.234);
     ASSERT_EQ("23 this is a string e 4.23", text );
+
+    //test output longer than any internal buffer is not truncated
+    {
+      const std::string value(100000, 'a');
+      std::string text = ra::strings::format("[%s]", value.c_str());
+      ASSERT_EQ(value.size() + 2, text.size());
+      ASSERT_EQ('[', text[0]);
+      ASSERT_EQ(']', text[text.size()-1]);
+    }
+
+    //test empty output
+    ASSERT_EQ("", ra::strings::format("%s", ""));
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testAppendFormat)
+  {
+    std::string text = "foo";
+    ra::strings::appendFormat(text, " %d", 42);
+    ra::strings::appendFormat(text, " %s", "bar");
+    ASSERT_EQ("foo 42 bar", text);
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestString, testStringBuilder)
+  {
+    //test all types
+    {
+      StringBuilder builder;
+      builder << "foo" << std::string("BAR") << StringRef("baz", 2) << ' ' << (int8_t)-23 << ' ' << (uint8_t)200 << ' ' << (int16_t)-31234 << ' ' << (uint16_t)51234;
+      builder << ' ' << (int32_t)-2147483600l << ' ' << (uint32_t)4123456789ul << ' ' << (int64_t)-9123456789012345678ll << ' ' << (uint64_t)18123456789012345678ull;
+      builder << ' ' << 2.5 << ' ' << 0.1f;
+      ASSERT_EQ("fooBARba -23 200 -31234 51234 -2147483600 4123456789 -9123456789012345678 18123456789012345678 2.5 0.1", builder.toString());
+      ASSERT_EQ(builder.size(), strlen(builder.c_str()));
+    }
+
+    //test pointers are identical to operator<<
+    {
+      const void * value = (const void *)0x12345678;
+      std::string expected;
+      expected << value;
+      StringBuilder builder;
+      builder << value;
+      ASSERT_EQ(expected, builder.toString());
+    }
+
+    //test growth from inline buffer to heap
+    {
+      StringBuilder builder;
+      std::string expected;
+      for(uint32_t i=0; i<10000; i++)
+      {
+        builder << i << ',';
+        expected << i << ",";
+      }
+      ASSERT_EQ(expected, builder.toString());
+      ASSERT_GE(builder.capacity(), builder.size());
+
+      //test release
+      const char * heapBuffer = builder.data();
+      std::string released;
+      builder.release(released);
+      ASSERT_EQ(expected, released);
+      ASSERT_EQ(heapBuffer, released.data()); //no copy
+      ASSERT_TRUE(builder.empty());
+      ASSERT_EQ("", std::string(builder.c_str()));
+    }
+
+    //test reserve and copy
+    {
+      StringBuilder builder(1000);
+      ASSERT_GE(builder.capacity(), 1000);
+      builder << "copy me";
+      StringBuilder copy = builder;
+      builder.clear();
+      ASSERT_EQ("copy me", copy.toString());
+      ASSERT_EQ("", builder.toString());
+    }
+
+    //test appending the content of the builder to itself
+    {
+      StringBuilder builder;
+      std::string expected;
+
+      //from inline buffer to heap
+      builder.append(std::string(200, 'x'));
+      expected.append(200, 'x');
+      builder.append(builder.data(), builder.size());
+      expected.append(expected);
+      ASSERT_EQ(expected, builder.toString());
+
+      //heap growth
+      for(size_t i=0; i<5; i++)
+      {
+        builder.append(builder.data() + 10, builder.size() - 10);
+        expected.append(expected.substr(10));
+        ASSERT_EQ(expected, builder.toString());
+      }
+
+    }
+
+    //test appending a character of the builder to itself
+    {
+      StringBuilder builder;
+      std::string expected;
+      for(size_t i=0; i<1000; i++)
+      {
+        char c = (char)('a' + i % 26);
+        builder.append(c);
+        builder.append(builder.data()[builder.size() - 1]);
+        expected.append(2, c);
+      }
+      ASSERT_EQ(expected, builder.toString());
+    }
   }
   //--------------------------------------------------------------------------------------------------
 } //namespace test
@@ -0,0 +1,293 @@
+/**********************************************************************************
+ * MIT License
+ * 
+ * Copyright (c) 2018 Antoine Beauchamp
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *********************************************************************************/
+
+#include "TestUnicode.h"
+#include "rapidassist/unicode.h"
+#include "rapidassist/time_.h"
+
+#include <stdio.h> //for printf()
+
+namespace ra { namespace unicode { namespace test
+{
+
+  //--------------------------------------------------------------------------------------------------
+  void TestUnicode::SetUp()
+  {
+  }
+  //--------------------------------------------------------------------------------------------------
+  void TestUnicode::TearDown()
+  {
+  }
+  //--------------------------------------------------------------------------------------------------
+  bool isValidUtf8(const char * iValue)
+  {
+    return ra::unicode::isValidUtf8(std::string(iValue));
+  }
+  //--------------------------------------------------------------------------------------------------
+  std::string getMixedText(size_t iSize)
+  {
+    //mostly ASCII text with some 2, 3 and 4 bytes sequences
+    static const char * words[] = {
+      "The quick brown fox jumps over the lazy dog. ",
+      "caf\xC3\xA9 ",
+      "\xE2\x82\xAC ",
+      "\xF0\x9F\x98\x80 ",
+      "0123456789abcdefghijklmnopqrstuvwxyz ",
+    };
+    static const size_t NUM_WORDS = sizeof(words)/sizeof(words[0]);
+    std::string text;
+    text.reserve(iSize + 64);
+    for(size_t i=0; text.size() < iSize; i++)
+    {
+      text.append(words[(i * 7) % NUM_WORDS]);
+    }
+    return text;
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestUnicode, testIsValidUtf8)
+  {
+    //valid
+    ASSERT_TRUE( isValidUtf8("") );
+    ASSERT_TRUE( isValidUtf8("hello world") );
+    ASSERT_TRUE( isValidUtf8("caf\xC3\xA9") );                //U+00E9
+    ASSERT_TRUE( isValidUtf8("\xE2\x82\xAC") );               //U+20AC
+    ASSERT_TRUE( isValidUtf8("\xED\x9F\xBF") );               //U+D7FF
+    ASSERT_TRUE( isValidUtf8("\xEE\x80\x80") );               //U+E000
+    ASSERT_TRUE( isValidUtf8("\xF0\x9F\x98\x80") );           //U+1F600
+    ASSERT_TRUE( isValidUtf8("\xF4\x8F\xBF\xBF") );           //U+10FFFF
+    ASSERT_TRUE( ra::unicode::isValidUtf8(std::string("a\0b", 3)) );
+
+    //invalid
+    ASSERT_FALSE( isValidUtf8("\x80") );                      //lone continuation byte
+    ASSERT_FALSE( isValidUtf8("\xC3") );                      //truncated
+    ASSERT_FALSE( isValidUtf8("\xC3\x28") );                  //invalid continuation byte
+    ASSERT_FALSE( isValidUtf8("\xC0\xAF") );                  //overlong
+    ASSERT_FALSE( isValidUtf8("\xE0\x80\xAF") );              //overlong
+    ASSERT_FALSE( isValidUtf8("\xF0\x80\x80\xAF") );          //overlong
+    ASSERT_FALSE( isValidUtf8("\xED\xA0\x80") );              //surrogate U+D800
+    ASSERT_FALSE( isValidUtf8("\xF4\x90\x80\x80") );          //above U+10FFFF
+    ASSERT_FALSE( isValidUtf8("\xF5\x80\x80\x80") );
+    ASSERT_FALSE( isValidUtf8("\xFF") );
+    ASSERT_FALSE( isValidUtf8("\xE2\x82") );                  //truncated
+
+    //invalid sequences after a long ASCII prefix (SSE2 path)
+    std::string text(100, 'a');
+    ASSERT_TRUE( ra::unicode::isValidUtf8(text) );
+    for(size_t i=0; i<text.size(); i++)
+    {
+      std::string invalid = text;
+      invalid[i] = (char)0x80;
+      ASSERT_FALSE( ra::unicode::isValidUtf8(invalid) ) << "at offset " << i;
+    }
+
+    //NULL buffer
+    ASSERT_TRUE( ra::unicode::isValidUtf8(NULL, 0) );
+    ASSERT_FALSE( ra::unicode::isValidUtf8(NULL, 1) );
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestUnicode, testCountCodePoints)
+  {
+    ASSERT_EQ(0, countCodePoints("", 0));
+    ASSERT_EQ(0, countCodePoints(NULL, 10));
+    ASSERT_EQ(5, countCodePoints("hello", 5));
+    ASSERT_EQ(4, countCodePoints("caf\xC3\xA9", 5));
+    ASSERT_EQ(1, countCodePoints("\xF0\x9F\x98\x80", 4));
+
+    //compare with the number of decoded code points
+    const std::string text = getMixedText(1000);
+    Utf32Vector codePoints;
+    ASSERT_TRUE( utf8ToUtf32(text.data(), text.size(), codePoints) );
+    ASSERT_EQ(codePoints.size(), countCodePoints(text.data(), text.size()));
+    for(size_t i=0; i<64; i++)
+    {
+      //all alignments and lengths
+      std::string sub = text.substr(i, text.size() - 2*i);
+      Utf32Vector subCodePoints;
+      if (utf8ToUtf32(sub.data(), sub.size(), subCodePoints))
+      {
+        ASSERT_EQ(subCodePoints.size(), countCodePoints(sub.data(), sub.size()));
+      }
+    }
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestUnicode, testUtf8ToUtf16)
+  {
+    Utf16Vector output;
+    ASSERT_TRUE( utf8ToUtf16("", 0, output) );
+    ASSERT_TRUE( output.empty() );
+
+    const std::string value = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    ASSERT_TRUE( utf8ToUtf16(value.data(), value.size(), output) );
+    ASSERT_EQ(5, output.size());
+    ASSERT_EQ(0x0061, output[0]);
+    ASSERT_EQ(0x00E9, output[1]);
+    ASSERT_EQ(0x20AC, output[2]);
+    ASSERT_EQ(0xD83D, output[3]);
+    ASSERT_EQ(0xDE00, output[4]);
+
+    //long ASCII text
+    const std::string ascii = "The quick brown fox jumps over the lazy dog";
+    ASSERT_TRUE( utf8ToUtf16(ascii.data(), ascii.size(), output) );
+    ASSERT_EQ(ascii.size(), output.size());
+    for(size_t i=0; i<ascii.size(); i++)
+    {
+      ASSERT_EQ((uint16_t)ascii[i], output[i]);
+    }
+
+    //invalid
+    const std::string invalid = ascii + "\xC0\xAF";
+    ASSERT_FALSE( utf8ToUtf16(invalid.data(), invalid.size(), output) );
+    ASSERT_TRUE( output.empty() );
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestUnicode, testUtf8ToUtf32)
+  {
+    Utf32Vector output;
+    ASSERT_TRUE( utf8ToUtf32("", 0, output) );
+    ASSERT_TRUE( output.empty() );
+
+    const std::string value = "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+    ASSERT_TRUE( utf8ToUtf32(value.data(), value.size(), output) );
+    ASSERT_EQ(4, output.size());
+    ASSERT_EQ(0x000061, output[0]);
+    ASSERT_EQ(0x0000E9, output[1]);
+    ASSERT_EQ(0x0020AC, output[2]);
+    ASSERT_EQ(0x01F600, output[3]);
+
+    //invalid
+    const std::string invalid = "abc\xED\xA0\x80";
+    ASSERT_FALSE( utf8ToUtf32(invalid.data(), invalid.size(), output) );
+    ASSERT_TRUE( output.empty() );
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestUnicode, testUtf16ToUtf8)
+  {
+    std::string output;
+    ASSERT_TRUE( utf16ToUtf8(NULL, 0, output) );
+    ASSERT_TRUE( output.empty() );
+
+    const uint16_t value[] = {0x0061, 0x00E9, 0x20AC, 0xD83D, 0xDE00};
+    ASSERT_TRUE( utf16ToUtf8(value, 5, output) );
+    ASSERT_EQ(std::string("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"), output);
+
+    //unpaired surrogates
+    const uint16_t highOnly[] = {0x0061, 0xD83D};
+    ASSERT_FALSE( utf16ToUtf8(highOnly, 2, output) );
+    ASSERT_TRUE( output.empty() );
+    const uint16_t lowOnly[] = {0xDE00, 0x0061};
+    ASSERT_FALSE( utf16ToUtf8(lowOnly, 2, output) );
+    const uint16_t highHigh[] = {0xD83D, 0xD83D};
+    ASSERT_FALSE( utf16ToUtf8(highHigh, 2, output) );
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestUnicode, testUtf32ToUtf8)
+  {
+    std::string output;
+    const uint32_t value[] = {0x000061, 0x0000E9, 0x0020AC, 0x01F600, 0x10FFFF};
+    ASSERT_TRUE( utf32ToUtf8(value, 5, output) );
+    ASSERT_EQ(std::string("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xF4\x8F\xBF\xBF"), output);
+
+    const uint32_t surrogate[] = {0x000061, 0x00D800};
+    ASSERT_FALSE( utf32ToUtf8(surrogate, 2, output) );
+    ASSERT_TRUE( output.empty() );
+    const uint32_t tooLarge[] = {0x110000};
+    ASSERT_FALSE( utf32ToUtf8(tooLarge, 1, output) );
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestUnicode, testRoundTrip)
+  {
+    const std::string text = getMixedText(10000);
+    ASSERT_TRUE( ra::unicode::isValidUtf8(text) );
+
+    Utf16Vector utf16;
+    ASSERT_TRUE( utf8ToUtf16(text.data(), text.size(), utf16) );
+    std::string fromUtf16;
+    ASSERT_TRUE( utf16ToUtf8(&utf16[0], utf16.size(), fromUtf16) );
+    ASSERT_EQ(text, fromUtf16);
+
+    Utf32Vector utf32;
+    ASSERT_TRUE( utf8ToUtf32(text.data(), text.size(), utf32) );
+    std::string fromUtf32;
+    ASSERT_TRUE( utf32ToUtf8(&utf32[0], utf32.size(), fromUtf32) );
+    ASSERT_EQ(text, fromUtf32);
+
+    //all valid code points
+    Utf32Vector all;
+    for(uint32_t c=1; c<=0x10FFFF; c++)
+    {
+      if (c < 0xD800 || c > 0xDFFF)
+        all.push_back(c);
+    }
+    std::string allUtf8;
+    ASSERT_TRUE( utf32ToUtf8(&all[0], all.size(), allUtf8) );
+    ASSERT_TRUE( ra::unicode::isValidUtf8(allUtf8) );
+    ASSERT_EQ(all.size(), countCodePoints(allUtf8.data(), allUtf8.size()));
+    ASSERT_TRUE( utf8ToUtf16(allUtf8.data(), allUtf8.size(), utf16) );
+    ASSERT_TRUE( utf16ToUtf8(&utf16[0], utf16.size(), fromUtf16) );
+    ASSERT_EQ(allUtf8, fromUtf16);
+    ASSERT_TRUE( utf8ToUtf32(allUtf8.data(), allUtf8.size(), utf32) );
+    ASSERT_TRUE( utf32 == all );
+  }
+  //--------------------------------------------------------------------------------------------------
+  TEST_F(TestUnicode, testUnicodePerformance)
+  {
+    static const size_t BUFFER_SIZE = 16 * 1024 * 1024;
+    const std::string ascii(BUFFER_SIZE, 'a');
+    const std::string mixed = getMixedText(BUFFER_SIZE);
+    const double megabytes = (double)BUFFER_SIZE / (1024.0 * 1024.0);
+
+    double timeStart = ra::time::getMicrosecondsTimer();
+    bool valid = ra::unicode::isValidUtf8(ascii);
+    double timeAscii = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_TRUE( valid );
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    valid = ra::unicode::isValidUtf8(mixed);
+    double timeMixed = ra::time::getMicrosecondsTimer() - timeStart;
+    ASSERT_TRUE( valid );
+
+    timeStart = ra::time::getMicrosecondsTimer();
+    size_t count = countCodePoints(mixed.data(), mixed.size());
+    double timeCount = ra::time::getMicrosecondsTimer() - timeStart;
+
+    Utf16Vector utf16;
+    timeStart = ra::time::getMicrosecondsTimer();
+    ASSERT_TRUE( utf8ToUtf16(mixed.data(), mixed.size(), utf16) );
+    double timeUtf16 = ra::time::getMicrosecondsTimer() - timeStart;
+
+    std::string utf8;
+    timeStart = ra::time::getMicrosecondsTimer();
+    ASSERT_TRUE( utf16ToUtf8(&utf16[0], utf16.size(), utf8) );
+    double timeUtf8 = ra::time::getMicrosecondsTimer() - timeStart;
+
+    printf("isValidUtf8() ASCII: %.0f MB/s\n", megabytes / timeAscii);
+    printf("isValidUtf8() mixed: %.0f MB/s\n", megabytes / timeMixed);
+    printf("countCodePoints(): %.0f MB/s (%lu code points)\n", megabytes / timeCount, (unsigned long)count);
+    printf("utf8ToUtf16(): %.0f MB/s\n", megabytes / timeUtf16);
+    printf("utf16ToUtf8(): %.0f MB/s\n", megabytes / timeUtf8);
+  }
+  //--------------------------------------------------------------------------------------------------
+} //namespace test
+} //namespace unicode
+} //namespace ra